@@ -71,12 +71,11 @@ void AircraftManager::loadAircraft() {
     table->setRowCount(0);
 
     DataStore& store = DataStore::getInstance();
-    auto aircraftList = store.getAllAircraft();
-
-    for (const auto& ac : aircraftList) {
-        int row = table->rowCount();
-        table->insertRow(row);
+    table->setRowCount(static_cast<int>(store.getAircraftCount()));
 
+    int row = 0;
+    for (const Aircraft* record : store.getAircraftTable().valuesByKey()) {
+        const Aircraft& ac = *record;
         table->setItem(row, 0, new QTableWidgetItem(QString::fromStdString(ac.id)));
         table->setItem(row, 1, new QTableWidgetItem(QString::fromStdString(ac.model)));
         table->setItem(row, 2, new QTableWidgetItem(QString::number(ac.capacity)));
@@ -84,6 +83,7 @@ void AircraftManager::loadAircraft() {
         table->setItem(row, 4, new QTableWidgetItem(QString::number(ac.fuelConsumption, 'f', 2)));
         table->setItem(row, 5, new QTableWidgetItem(QString::fromStdString(
                                    Aircraft::statusToString(ac.status))));
+        ++row;
     }
 }
 
@@ -110,7 +110,7 @@ void AircraftManager::onAdd() {
     DataStore& store = DataStore::getInstance();
     if (store.addAircraft(aircraft)) {
         QMessageBox::information(this, "Success", "Aircraft added successfully.");
-        store.saveAll();
+        store.syncJournal();
         loadAircraft();
 
         // Clear form
@@ -141,7 +141,7 @@ void AircraftManager::onDelete() {
         DataStore& store = DataStore::getInstance();
         if (store.deleteAircraft(id.toStdString())) {
             QMessageBox::information(this, "Success", "Aircraft deleted.");
-            store.saveAll();
+            store.syncJournal();
             loadAircraft();
         }
     }
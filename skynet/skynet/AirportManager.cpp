@@ -97,18 +97,18 @@ void AirportManager::loadAirports() {
     table->setRowCount(0);
 
     DataStore& store = DataStore::getInstance();
-    auto airports = store.getAllAirports();
-
-    for (const auto& airport : airports) {
-        int row = table->rowCount();
-        table->insertRow(row);
+    table->setRowCount(static_cast<int>(store.getAirportCount()));
 
+    int row = 0;
+    for (const Airport* record : store.getAirportTable().valuesByKey()) {
+        const Airport& airport = *record;
         table->setItem(row, 0, new QTableWidgetItem(QString::fromStdString(airport.code)));
         table->setItem(row, 1, new QTableWidgetItem(QString::fromStdString(airport.name)));
         table->setItem(row, 2, new QTableWidgetItem(QString::fromStdString(airport.city)));
         table->setItem(row, 3, new QTableWidgetItem(QString::fromStdString(airport.country)));
         table->setItem(row, 4, new QTableWidgetItem(QString::number(airport.latitude, 'f', 4)));
         table->setItem(row, 5, new QTableWidgetItem(QString::number(airport.longitude, 'f', 4)));
+        ++row;
     }
 
     table->resizeColumnsToContents();
@@ -180,7 +180,7 @@ void AirportManager::onAdd() {
 
     DataStore& store = DataStore::getInstance();
     if (store.addAirport(airport)) {
-        store.saveAll();
+        store.syncJournal();
         QMessageBox::information(this, "✅ Success",
                                  QString("Airport '%1' added successfully!\n\nYou can now create routes using this airport.")
                                      .arg(QString::fromStdString(airport.code)));
@@ -220,7 +220,7 @@ void AirportManager::onUpdate() {
 
     DataStore& store = DataStore::getInstance();
     if (store.updateAirport(airport)) {
-        store.saveAll();
+        store.syncJournal();
         QMessageBox::information(this, "✅ Success",
                                  QString("Airport '%1' updated successfully!").arg(code));
         loadAirports();
@@ -254,7 +254,7 @@ void AirportManager::onDelete() {
     if (reply == QMessageBox::Yes) {
         DataStore& store = DataStore::getInstance();
         if (store.deleteAirport(code.toStdString())) {
-            store.saveAll();
+            store.syncJournal();
             QMessageBox::information(this, "✅ Deleted",
                                      QString("Airport '%1' has been deleted.").arg(code));
             loadAirports();
@@ -0,0 +1,111 @@
+#include "AtomicFileWriter.h"
+#include "FileUtil.h"
+#include <cstring>
+
+// ==================== FILE BUFFER ====================
+
+void AtomicFileWriter::FileBuffer::attach(std::FILE* target, size_t bufferSize) {
+    file = target;
+    buffer.resize(bufferSize > 0 ? bufferSize : 1);
+    setp(buffer.data(), buffer.data() + buffer.size());
+}
+
+bool AtomicFileWriter::FileBuffer::flushBuffer() {
+    const size_t pending = static_cast<size_t>(pptr() - pbase());
+    if (pending == 0) {
+        return true;
+    }
+    if (!file || std::fwrite(pbase(), 1, pending, file) != pending) {
+        return false;
+    }
+    setp(buffer.data(), buffer.data() + buffer.size());
+    return true;
+}
+
+AtomicFileWriter::FileBuffer::int_type AtomicFileWriter::FileBuffer::overflow(int_type ch) {
+    if (!file || !flushBuffer()) {
+        return traits_type::eof();
+    }
+    if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
+    }
+    return traits_type::not_eof(ch);
+}
+
+std::streamsize AtomicFileWriter::FileBuffer::xsputn(const char* data, std::streamsize size) {
+    if (!file) {
+        return 0;
+    }
+
+    const size_t count = static_cast<size_t>(size);
+    const size_t room = static_cast<size_t>(epptr() - pptr());
+    if (count <= room) {
+        std::memcpy(pptr(), data, count);
+        pbump(static_cast<int>(count));
+        return size;
+    }
+
+    // Too big for what is left: drain the buffer, then either start a
+    // fresh one or hand large blocks straight to the file
+    if (!flushBuffer()) {
+        return 0;
+    }
+    if (count < buffer.size()) {
+        std::memcpy(pptr(), data, count);
+        pbump(static_cast<int>(count));
+        return size;
+    }
+    return std::fwrite(data, 1, count, file) == count ? size : 0;
+}
+
+int AtomicFileWriter::FileBuffer::sync() {
+    return flushBuffer() ? 0 : -1;
+}
+
+// ==================== WRITER ====================
+
+AtomicFileWriter::AtomicFileWriter(const std::string& targetPath, size_t bufferSize)
+    : path(targetPath), tempPath(targetPath + ".tmp"), file(nullptr), out(&buffer) {
+    file = std::fopen(tempPath.c_str(), "wb");
+    if (!file) {
+        out.setstate(std::ios::badbit);
+        return;
+    }
+
+    // All buffering happens in FileBuffer
+    std::setvbuf(file, nullptr, _IONBF, 0);
+    buffer.attach(file, bufferSize);
+}
+
+AtomicFileWriter::~AtomicFileWriter() {
+    discard();
+}
+
+bool AtomicFileWriter::commit() {
+    if (!file) {
+        return false;
+    }
+
+    bool ok = out.good() && buffer.flushBuffer() && FileUtil::syncFile(file);
+    ok &= std::fclose(file) == 0;
+    file = nullptr;
+
+    if (!ok || !FileUtil::replaceFile(tempPath, path)) {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+
+    // Durable rename; the data itself is already on disk
+    FileUtil::syncParentDirectory(path);
+    return true;
+}
+
+void AtomicFileWriter::discard() {
+    if (!file) {
+        return;
+    }
+    std::fclose(file);
+    file = nullptr;
+    std::remove(tempPath.c_str());
+}
@@ -0,0 +1,86 @@
+#ifndef ATOMICFILEWRITER_H
+#define ATOMICFILEWRITER_H
+#include <cstdio>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Crash-safe whole-file writer: temp file, fsync, atomic rename
+ *
+ * Why not std::ofstream on the target?
+ * - Opening the target truncates it at once; a crash or a full disk
+ *   mid-write left a partial data file that the next loadAll() read as
+ *   if it were complete
+ * - Here everything goes to "<path>.tmp". commit() syncs it to disk and
+ *   renames it over the target, so the target is always either the old
+ *   file or the complete new one
+ *
+ * Why a custom buffer?
+ * - Output collects in one large buffer (1 MB by default) that goes to
+ *   the OS in a few big writes; nothing is flushed per line
+ * - The single fsync in commit() is the only wait for the disk
+ *
+ * Usage:
+ *   AtomicFileWriter file(path);
+ *   if (!file.isOpen()) return false;
+ *   file.stream() << header << "\n";
+ *   ...
+ *   return file.commit();
+ *
+ * Destroying a writer without commit() deletes the temp file and leaves
+ * the target untouched.
+ */
+class AtomicFileWriter {
+public:
+    static const size_t DEFAULT_BUFFER_SIZE = 1 << 20;
+
+    explicit AtomicFileWriter(const std::string& path,
+                              size_t bufferSize = DEFAULT_BUFFER_SIZE);
+    ~AtomicFileWriter();
+
+    AtomicFileWriter(const AtomicFileWriter&) = delete;
+    AtomicFileWriter& operator=(const AtomicFileWriter&) = delete;
+
+    bool isOpen() const { return file != nullptr; }
+    std::ostream& stream() { return out; }
+    void write(const char* data, size_t size) {
+        out.write(data, static_cast<std::streamsize>(size));
+    }
+
+    /**
+     * Flush, fsync and rename over the target
+     * @return false (target unchanged) if any write or the rename failed
+     */
+    bool commit();
+
+    // Drop the temp file without touching the target
+    void discard();
+
+private:
+    // Stream buffer over an unbuffered FILE*
+    class FileBuffer : public std::streambuf {
+    public:
+        FileBuffer() : file(nullptr) {}
+        void attach(std::FILE* target, size_t bufferSize);
+        bool flushBuffer();
+
+    protected:
+        int_type overflow(int_type ch) override;
+        std::streamsize xsputn(const char* data, std::streamsize size) override;
+        int sync() override;
+
+    private:
+        std::FILE* file;
+        std::vector<char> buffer;
+    };
+
+    std::string path;
+    std::string tempPath;
+    std::FILE* file;
+    FileBuffer buffer;
+    std::ostream out;
+};
+
+#endif // ATOMICFILEWRITER_H
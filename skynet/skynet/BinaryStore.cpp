@@ -0,0 +1,307 @@
+#include "BinaryStore.h"
+#include "MappedFile.h"
+#include "AtomicFileWriter.h"
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+const char MAGIC[8] = {'S', 'K', 'Y', 'N', 'E', 'T', 'B', 'N'};
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+// Appends fixed-size values and length-prefixed strings to one buffer
+class Writer {
+public:
+    template <typename T>
+    void put(T value) {
+        static_assert(std::is_trivially_copyable<T>::value, "raw value");
+        out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void putString(const std::string& s) {
+        put<uint32_t>(static_cast<uint32_t>(s.size()));
+        out.append(s);
+    }
+
+    template <typename T>
+    void putArray(const std::vector<T>& values) {
+        if (!values.empty()) {
+            out.append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+        }
+    }
+
+    std::string out;
+};
+
+// Bounds-checked reader over the mapping; any overrun clears ok
+class Reader {
+public:
+    Reader(const char* data, size_t size) : p(data), end(data + size), ok(true) {}
+
+    template <typename T>
+    T get() {
+        T value{};
+        if (!take(sizeof(T))) return value;
+        std::memcpy(&value, p - sizeof(T), sizeof(T));
+        return value;
+    }
+
+    std::string getString() {
+        uint32_t length = get<uint32_t>();
+        if (!take(length)) return std::string();
+        return std::string(p - length, length);
+    }
+
+    template <typename T>
+    void getArray(std::vector<T>& values, size_t count) {
+        if (count > static_cast<size_t>(end - p) / sizeof(T) || !take(count * sizeof(T))) {
+            ok = false;
+            return;
+        }
+        values.resize(count);
+        if (count > 0) {
+            std::memcpy(values.data(), p - count * sizeof(T), count * sizeof(T));
+        }
+    }
+
+    // Record counts can't exceed what the remaining bytes could hold
+    uint32_t getCount(size_t minRecordSize = 1) {
+        uint32_t count = get<uint32_t>();
+        if (count > static_cast<size_t>(end - p) / minRecordSize) ok = false;
+        return ok ? count : 0;
+    }
+
+    bool good() const { return ok; }
+    bool atEnd() const { return p == end; }
+
+private:
+    bool take(size_t n) {
+        if (!ok || n > static_cast<size_t>(end - p)) {
+            ok = false;
+            return false;
+        }
+        p += n;
+        return true;
+    }
+
+    const char* p;
+    const char* end;
+    bool ok;
+};
+
+}  // namespace
+
+bool BinaryStore::save(const std::string& path,
+                       const EntityTable<Airport>& airports,
+                       const EntityTable<Aircraft>& aircraft,
+                       const EntityTable<Route>& routes,
+                       const EntityTable<Flight>& flights,
+                       const CompactGraph& graph) {
+    Writer w;
+    w.out.append(MAGIC, sizeof(MAGIC));
+    w.put<uint32_t>(FORMAT_VERSION);
+    w.put<uint32_t>(BYTE_ORDER_MARK);
+    w.put<uint64_t>(0);   // File size, patched below
+
+    w.put<uint32_t>(static_cast<uint32_t>(airports.size()));
+    for (const Airport* record : airports.valuesByKey()) {
+        const Airport& a = *record;
+        w.putString(a.code);
+        w.putString(a.name);
+        w.putString(a.city);
+        w.putString(a.country);
+        w.put<double>(a.latitude);
+        w.put<double>(a.longitude);
+    }
+
+    w.put<uint32_t>(static_cast<uint32_t>(aircraft.size()));
+    for (const Aircraft* record : aircraft.valuesByKey()) {
+        const Aircraft& ac = *record;
+        w.putString(ac.id);
+        w.putString(ac.model);
+        w.put<int32_t>(ac.capacity);
+        w.put<double>(ac.cruiseSpeed);
+        w.put<double>(ac.fuelConsumption);
+        w.put<uint8_t>(static_cast<uint8_t>(ac.status));
+    }
+
+    w.put<uint32_t>(static_cast<uint32_t>(routes.size()));
+    for (const Route* record : routes.valuesByKey()) {
+        const Route& r = *record;
+        w.putString(r.origin);
+        w.putString(r.destination);
+        w.put<double>(r.distance);
+        w.put<double>(r.baseCost);
+        w.put<uint8_t>(r.operational ? 1 : 0);
+    }
+
+    w.put<uint32_t>(static_cast<uint32_t>(flights.size()));
+    for (const Flight* record : flights.valuesByKey()) {
+        const Flight& f = *record;
+        w.putString(f.flightNumber);
+        w.putString(f.aircraftId);
+        w.put<uint32_t>(static_cast<uint32_t>(f.route.size()));
+        for (const auto& leg : f.route) {
+            w.putString(leg);
+        }
+        w.put<double>(f.totalDistance);
+        w.put<double>(f.totalCost);
+        w.put<double>(f.estimatedTime);
+        w.putString(f.departureTime);
+        w.putString(f.status);
+    }
+
+    // Forward CSR exactly as CompactGraph holds it
+    const uint32_t nodeCount = graph.getNodeCount();
+    const uint32_t edgeCount = graph.getEdgeCount();
+    w.put<uint32_t>(nodeCount);
+    w.put<uint32_t>(edgeCount);
+
+    std::vector<uint32_t> offsets(nodeCount + 1, 0);
+    std::vector<CompactGraph::NodeId> targets(edgeCount);
+    std::vector<double> weights(edgeCount);
+    std::vector<double> costs(edgeCount);
+    for (CompactGraph::NodeId u = 0; u < nodeCount; ++u) {
+        w.putString(graph.getNodeCode(u));
+        offsets[u + 1] = graph.edgeEnd(u);
+        for (uint32_t e = graph.edgeBegin(u); e < graph.edgeEnd(u); ++e) {
+            targets[e] = graph.edgeTarget(e);
+            weights[e] = graph.edgeWeight(e);
+            costs[e] = graph.edgeCost(e);
+        }
+    }
+    w.putArray(offsets);
+    w.putArray(targets);
+    w.putArray(weights);
+    w.putArray(costs);
+
+    const uint64_t fileSize = w.out.size();
+    std::memcpy(&w.out[sizeof(MAGIC) + 2 * sizeof(uint32_t)], &fileSize, sizeof(fileSize));
+
+    AtomicFileWriter file(path);
+    if (!file.isOpen()) {
+        return false;
+    }
+    file.write(w.out.data(), w.out.size());
+    return file.commit();
+}
+
+bool BinaryStore::load(const std::string& path, Contents& contents, std::string& error) {
+    MappedFile file;
+    if (!file.open(path)) {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    if (file.size() < sizeof(MAGIC) || std::memcmp(file.data(), MAGIC, sizeof(MAGIC)) != 0) {
+        error = "not a SkyNet binary image";
+        return false;
+    }
+    Reader body(file.data() + sizeof(MAGIC), file.size() - sizeof(MAGIC));
+
+    uint32_t version = body.get<uint32_t>();
+    uint32_t byteOrder = body.get<uint32_t>();
+    uint64_t fileSize = body.get<uint64_t>();
+    if (version != FORMAT_VERSION) {
+        error = "format version " + std::to_string(version) + ", expected " +
+                std::to_string(FORMAT_VERSION);
+        return false;
+    }
+    if (byteOrder != BYTE_ORDER_MARK || fileSize != file.size()) {
+        error = "byte order or size mismatch";
+        return false;
+    }
+
+    // Keys are unique in the image; size each table once up front.
+    // getCount() bounds the count by the smallest possible record.
+    uint32_t count = body.getCount(32);
+    contents.airports.reserve(count);
+    for (uint32_t i = 0; i < count && body.good(); ++i) {
+        Airport a;
+        a.code = body.getString();
+        a.name = body.getString();
+        a.city = body.getString();
+        a.country = body.getString();
+        a.latitude = body.get<double>();
+        a.longitude = body.get<double>();
+        contents.airports.try_emplace(a.code, std::move(a));
+    }
+
+    count = body.getCount(29);
+    contents.aircraft.reserve(count);
+    for (uint32_t i = 0; i < count && body.good(); ++i) {
+        Aircraft ac;
+        ac.id = body.getString();
+        ac.model = body.getString();
+        ac.capacity = body.get<int32_t>();
+        ac.cruiseSpeed = body.get<double>();
+        ac.fuelConsumption = body.get<double>();
+        uint8_t status = body.get<uint8_t>();
+        ac.status = status <= static_cast<uint8_t>(AircraftStatus::RETIRED)
+                        ? static_cast<AircraftStatus>(status) : AircraftStatus::AVAILABLE;
+        contents.aircraft.try_emplace(ac.id, std::move(ac));
+    }
+
+    count = body.getCount(25);
+    contents.routes.reserve(count);
+    for (uint32_t i = 0; i < count && body.good(); ++i) {
+        Route route;
+        route.origin = body.getString();
+        route.destination = body.getString();
+        route.distance = body.get<double>();
+        route.baseCost = body.get<double>();
+        route.operational = body.get<uint8_t>() != 0;
+        contents.routes.try_emplace(route.getId(), std::move(route));
+    }
+
+    count = body.getCount(44);
+    contents.flights.reserve(count);
+    for (uint32_t i = 0; i < count && body.good(); ++i) {
+        Flight flight;
+        flight.flightNumber = body.getString();
+        flight.aircraftId = body.getString();
+        uint32_t legs = body.getCount();
+        flight.route.reserve(legs);
+        for (uint32_t k = 0; k < legs && body.good(); ++k) {
+            flight.route.push_back(body.getString());
+        }
+        flight.totalDistance = body.get<double>();
+        flight.totalCost = body.get<double>();
+        flight.estimatedTime = body.get<double>();
+        flight.departureTime = body.getString();
+        flight.status = body.getString();
+        contents.flights.try_emplace(flight.flightNumber, std::move(flight));
+    }
+
+    uint32_t nodeCount = body.getCount();
+    uint32_t edgeCount = body.get<uint32_t>();
+    std::vector<std::string> codes;
+    codes.reserve(nodeCount);
+    for (uint32_t i = 0; i < nodeCount && body.good(); ++i) {
+        codes.push_back(body.getString());
+    }
+
+    std::vector<uint32_t> offsets;
+    std::vector<CompactGraph::NodeId> targets;
+    std::vector<double> weights;
+    std::vector<double> costs;
+    body.getArray(offsets, static_cast<size_t>(nodeCount) + 1);
+    body.getArray(targets, edgeCount);
+    body.getArray(weights, edgeCount);
+    body.getArray(costs, edgeCount);
+
+    if (!body.good() || !body.atEnd()) {
+        error = "truncated or corrupt image";
+        return false;
+    }
+    if (!CompactGraph::isValidCsr(offsets, targets, nodeCount)) {
+        error = "invalid graph section";
+        return false;
+    }
+
+    contents.graph = std::make_shared<CompactGraph>(std::move(codes), std::move(offsets),
+                                                    std::move(targets), std::move(weights),
+                                                    std::move(costs));
+    return true;
+}
@@ -0,0 +1,68 @@
+#ifndef BINARYSTORE_H
+#define BINARYSTORE_H
+#include "airports.h"
+#include "aircraft.h"
+#include "Route.h"
+#include "Flight.h"
+#include "CompactGraph.h"
+#include "EntityTable.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * @brief Versioned binary image of all DataStore entities plus the CSR graph
+ *
+ * Why a binary format next to the CSVs?
+ * - Startup used to parse four text files and rebuild the graph before
+ *   the main window could appear
+ * - The image stores numbers in native binary and strings length-
+ *   prefixed, so loading is copying, not parsing
+ * - The CSR arrays of the flight network are stored as-is and adopted
+ *   by CompactGraph directly; no graph build on startup
+ * - The file is memory-mapped (MappedFile) and read in one pass
+ *
+ * The CSVs stay the editable source of truth: DataStore only uses the
+ * image while it is newer than every CSV and rewrites it after loading
+ * from CSV or saving.
+ *
+ * Layout (all integers little-endian, native doubles):
+ *   header   "SKYNETBN", format version, byte-order mark, file size
+ *   sections airports, aircraft, routes, flights (count + records)
+ *   graph    node count, edge count, node codes, offsets, targets,
+ *            weights, costs
+ * A file with another version, byte order or size is rejected and the
+ * caller falls back to CSV.
+ */
+class BinaryStore {
+public:
+    static const uint32_t FORMAT_VERSION = 1;
+
+    struct Contents {
+        EntityTable<Airport> airports;
+        EntityTable<Aircraft> aircraft;
+        EntityTable<Route> routes;
+        EntityTable<Flight> flights;
+        std::shared_ptr<CompactGraph> graph;
+    };
+
+    /**
+     * Write the image
+     * @return false on I/O failure
+     */
+    static bool save(const std::string& path,
+                     const EntityTable<Airport>& airports,
+                     const EntityTable<Aircraft>& aircraft,
+                     const EntityTable<Route>& routes,
+                     const EntityTable<Flight>& flights,
+                     const CompactGraph& graph);
+
+    /**
+     * Map and decode an image
+     * @param error Reason on failure (missing, stale version, truncated...)
+     * @return false if the file is missing or not a valid image
+     */
+    static bool load(const std::string& path, Contents& contents, std::string& error);
+};
+
+#endif // BINARYSTORE_H
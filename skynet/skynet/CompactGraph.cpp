@@ -0,0 +1,135 @@
+#include "CompactGraph.h"
+#include <cmath>
+#include <limits>
+
+CompactGraph::CompactGraph() : offsets(1, 0), reverseOffsets(1, 0) {}
+
+CompactGraph::CompactGraph(const Graph& graph) {
+    // Intern node codes in sorted order
+    const auto& nodes = graph.getNodes();
+    codes.assign(nodes.begin(), nodes.end());
+    indexCodes();
+
+    // Pack adjacency lists into flat arrays
+    const size_t edgeCount = graph.getEdgeCount();
+    offsets.reserve(codes.size() + 1);
+    targets.reserve(edgeCount);
+    weights.reserve(edgeCount);
+    costs.reserve(edgeCount);
+
+    offsets.push_back(0);
+    for (const auto& code : codes) {
+        for (const Edge& edge : graph.neighbors(code)) {
+            targets.push_back(ids.at(edge.destination));
+            weights.push_back(edge.weight);
+            costs.push_back(edge.cost);
+        }
+        offsets.push_back(static_cast<uint32_t>(targets.size()));
+    }
+
+    buildReverse();
+}
+
+CompactGraph::CompactGraph(std::vector<std::string> codes,
+                           std::vector<uint32_t> offsets,
+                           std::vector<NodeId> targets,
+                           std::vector<double> weights,
+                           std::vector<double> costs)
+    : codes(std::move(codes)), offsets(std::move(offsets)), targets(std::move(targets)),
+    weights(std::move(weights)), costs(std::move(costs)) {
+    indexCodes();
+    buildReverse();
+}
+
+bool CompactGraph::isValidCsr(const std::vector<uint32_t>& offsets,
+                              const std::vector<NodeId>& targets,
+                              size_t nodeCount) {
+    if (offsets.size() != nodeCount + 1 || offsets.front() != 0 ||
+        offsets.back() != targets.size()) {
+        return false;
+    }
+    for (size_t v = 0; v < nodeCount; ++v) {
+        if (offsets[v] > offsets[v + 1]) return false;
+    }
+    for (NodeId target : targets) {
+        if (target >= nodeCount) return false;
+    }
+    return true;
+}
+
+void CompactGraph::indexCodes() {
+    ids.reserve(codes.size());
+    for (NodeId id = 0; id < codes.size(); ++id) {
+        ids.emplace(codes[id], id);
+    }
+}
+
+void CompactGraph::buildReverse() {
+    // Mirror into reverse CSR: count in-degrees, prefix-sum, scatter
+    const size_t nodeCount = codes.size();
+    reverseOffsets.assign(nodeCount + 1, 0);
+    for (NodeId target : targets) {
+        ++reverseOffsets[target + 1];
+    }
+    for (size_t v = 0; v < nodeCount; ++v) {
+        reverseOffsets[v + 1] += reverseOffsets[v];
+    }
+
+    reverseSources.resize(targets.size());
+    reverseWeights.resize(targets.size());
+    reverseCosts.resize(targets.size());
+
+    std::vector<uint32_t> cursor(reverseOffsets.begin(), reverseOffsets.end() - 1);
+    for (NodeId u = 0; u < nodeCount; ++u) {
+        for (uint32_t e = offsets[u]; e < offsets[u + 1]; ++e) {
+            uint32_t slot = cursor[targets[e]]++;
+            reverseSources[slot] = u;
+            reverseWeights[slot] = weights[e];
+            reverseCosts[slot] = costs[e];
+        }
+    }
+}
+
+CompactGraph::NodeId CompactGraph::getNodeId(const std::string& code) const {
+    auto it = ids.find(code);
+    return (it != ids.end()) ? it->second : INVALID_NODE;
+}
+
+const std::string& CompactGraph::getNodeCode(NodeId id) const {
+    return codes[id];
+}
+
+bool CompactGraph::hasNode(const std::string& code) const {
+    return ids.find(code) != ids.end();
+}
+
+uint32_t CompactGraph::getNodeCount() const {
+    return static_cast<uint32_t>(codes.size());
+}
+
+uint32_t CompactGraph::getEdgeCount() const {
+    return static_cast<uint32_t>(targets.size());
+}
+
+void CompactGraph::setCoordinates(const std::string& code,
+                                  double latitude, double longitude) {
+    NodeId id = getNodeId(code);
+    if (id == INVALID_NODE) return;
+
+    if (latitudes.empty()) {
+        const double unknown = std::numeric_limits<double>::quiet_NaN();
+        latitudes.assign(codes.size(), unknown);
+        longitudes.assign(codes.size(), unknown);
+    }
+
+    latitudes[id] = latitude;
+    longitudes[id] = longitude;
+}
+
+bool CompactGraph::hasCoordinates(NodeId id) const {
+    return id < latitudes.size() && !std::isnan(latitudes[id]);
+}
+
+bool CompactGraph::isEmpty() const {
+    return codes.empty();
+}
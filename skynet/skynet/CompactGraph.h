@@ -0,0 +1,111 @@
+#ifndef COMPACTGRAPH_H
+#define COMPACTGRAPH_H
+#include "Graph.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Read-only compressed-sparse-row (CSR) snapshot of a Graph
+ *
+ * Why CSR over the adjacency list?
+ * - Graph keys nodes by std::string and every Edge owns a std::string,
+ *   so each relaxation does string compares and pointer chasing
+ * - CSR interns IATA codes to dense uint32_t ids and packs all edges
+ *   into flat contiguous arrays: neighbor scans become linear reads
+ * - Search state can live in plain vectors indexed by node id
+ *
+ * Layout:
+ * - Outgoing edges of node u are [offsets[u], offsets[u + 1])
+ * - targets/weights/costs are parallel arrays indexed by edge
+ * - A mirrored reverse CSR lists incoming edges of u as
+ *   [reverseOffsets[u], reverseOffsets[u + 1]) for backward searches
+ *
+ * Node ids follow sorted IATA order (same as Graph::getNodes()), so a
+ * given network always produces the same ids.
+ *
+ * Optional per-node coordinates (degrees) feed the A* great-circle
+ * heuristic; they are attached by the builder before the snapshot is
+ * shared.
+ *
+ * Immutable once built: rebuild from the Graph after data changes.
+ */
+class CompactGraph {
+public:
+    using NodeId = uint32_t;
+    static constexpr NodeId INVALID_NODE = UINT32_MAX;
+
+    CompactGraph();
+    explicit CompactGraph(const Graph& graph);
+
+    /**
+     * Adopt prebuilt forward CSR arrays (e.g. from a binary snapshot);
+     * the reverse CSR and code lookup are derived from them.
+     * Caller guarantees a well-formed CSR (see isValidCsr)
+     */
+    CompactGraph(std::vector<std::string> codes,
+                 std::vector<uint32_t> offsets,
+                 std::vector<NodeId> targets,
+                 std::vector<double> weights,
+                 std::vector<double> costs);
+
+    // Offsets monotonic from 0 to E, every target a valid node id
+    static bool isValidCsr(const std::vector<uint32_t>& offsets,
+                           const std::vector<NodeId>& targets,
+                           size_t nodeCount);
+
+    // Node lookup
+    NodeId getNodeId(const std::string& code) const;
+    const std::string& getNodeCode(NodeId id) const;
+    bool hasNode(const std::string& code) const;
+    uint32_t getNodeCount() const;
+    uint32_t getEdgeCount() const;
+
+    // Edge access: iterate e in [edgeBegin(u), edgeEnd(u))
+    uint32_t edgeBegin(NodeId u) const { return offsets[u]; }
+    uint32_t edgeEnd(NodeId u) const { return offsets[u + 1]; }
+    NodeId edgeTarget(uint32_t e) const { return targets[e]; }
+    double edgeWeight(uint32_t e) const { return weights[e]; }
+    double edgeCost(uint32_t e) const { return costs[e]; }
+
+    // Incoming edges: iterate e in [reverseEdgeBegin(v), reverseEdgeEnd(v))
+    uint32_t reverseEdgeBegin(NodeId v) const { return reverseOffsets[v]; }
+    uint32_t reverseEdgeEnd(NodeId v) const { return reverseOffsets[v + 1]; }
+    NodeId reverseEdgeSource(uint32_t e) const { return reverseSources[e]; }
+    double reverseEdgeWeight(uint32_t e) const { return reverseWeights[e]; }
+    double reverseEdgeCost(uint32_t e) const { return reverseCosts[e]; }
+
+    // Node coordinates (set by the builder, read by A*)
+    void setCoordinates(const std::string& code, double latitude, double longitude);
+    bool hasCoordinates(NodeId id) const;
+    double getLatitude(NodeId id) const { return latitudes[id]; }
+    double getLongitude(NodeId id) const { return longitudes[id]; }
+
+    bool isEmpty() const;
+
+private:
+    // Fill ids from codes
+    void indexCodes();
+
+    // Mirror the forward CSR into the reverse one
+    void buildReverse();
+
+    std::vector<std::string> codes;                // id -> IATA code
+    std::unordered_map<std::string, NodeId> ids;   // IATA code -> id
+
+    std::vector<uint32_t> offsets;   // V + 1 entries
+    std::vector<NodeId> targets;     // E entries
+    std::vector<double> weights;     // Distance in km
+    std::vector<double> costs;       // Operational cost
+
+    std::vector<uint32_t> reverseOffsets;   // V + 1 entries
+    std::vector<NodeId> reverseSources;     // E entries
+    std::vector<double> reverseWeights;
+    std::vector<double> reverseCosts;
+
+    std::vector<double> latitudes;   // NaN when unknown
+    std::vector<double> longitudes;
+};
+
+#endif // COMPACTGRAPH_H
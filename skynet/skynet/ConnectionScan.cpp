@@ -0,0 +1,148 @@
+#include "ConnectionScan.h"
+#include <algorithm>
+
+ConnectionScan::ConnectionScan()
+    : current(nullptr), generation(0), scannedCount(0) {}
+
+void ConnectionScan::reset(const Timetable& timetable) {
+    current = &timetable;
+
+    const size_t stopCount = timetable.getStopCount();
+    if (stamp.size() < stopCount) {
+        arrival.resize(stopCount);
+        ready.resize(stopCount);
+        enteredAt.resize(stopCount);
+        exitedAt.resize(stopCount);
+        stamp.resize(stopCount, 0);
+    }
+    const size_t tripCount = timetable.getTripCount();
+    if (tripStamp.size() < tripCount) {
+        tripBoardedAt.resize(tripCount);
+        tripStamp.resize(tripCount, 0);
+    }
+
+    // On wrap-around, stale stamps could alias the new generation
+    if (++generation == 0) {
+        std::fill(stamp.begin(), stamp.end(), 0);
+        std::fill(tripStamp.begin(), tripStamp.end(), 0);
+        generation = 1;
+    }
+
+    scannedCount = 0;
+}
+
+bool ConnectionScan::scan(const Timetable& timetable, StopId origin, StopId target,
+                          int64_t departAfter, int minConnection, int maxTravel) {
+    reset(timetable);
+    if (origin >= timetable.getStopCount()) {
+        return false;
+    }
+
+    const std::vector<Timetable::Connection>& connections = timetable.getConnections();
+    const int64_t start = departAfter - timetable.getBaseTime();
+    const int64_t limit = start + std::max(0, maxTravel);
+    const int64_t transfer = std::max(0, minConnection);
+
+    stamp[origin] = generation;
+    arrival[origin] = start;
+    ready[origin] = start;   // No connection time before the first flight
+
+    for (size_t i = timetable.findFirstDeparture(departAfter); i < connections.size(); ++i) {
+        const Timetable::Connection& connection = connections[i];
+        if (connection.departure > limit) {
+            break;
+        }
+        // Everything from here on leaves after the destination is reached
+        if (target != Timetable::INVALID_STOP && stamp[target] == generation &&
+            connection.departure >= arrival[target]) {
+            break;
+        }
+        ++scannedCount;
+
+        // Stay on a boarded flight, or board if at the airport in time
+        if (tripStamp[connection.trip] != generation) {
+            if (stamp[connection.from] != generation || ready[connection.from] > connection.departure) {
+                continue;
+            }
+            tripStamp[connection.trip] = generation;
+            tripBoardedAt[connection.trip] = static_cast<uint32_t>(i);
+        }
+
+        const StopId to = connection.to;
+        if (stamp[to] != generation || connection.arrival < arrival[to]) {
+            stamp[to] = generation;
+            arrival[to] = connection.arrival;
+            ready[to] = connection.arrival + transfer;
+            enteredAt[to] = tripBoardedAt[connection.trip];
+            exitedAt[to] = static_cast<uint32_t>(i);
+        }
+    }
+
+    return target == Timetable::INVALID_STOP || stamp[target] == generation;
+}
+
+int64_t ConnectionScan::getArrival(StopId stop) const {
+    return current->getBaseTime() + arrival[stop];
+}
+
+ConnectionScan::Itinerary ConnectionScan::findEarliestArrival(const Timetable& timetable,
+                                                              const std::string& origin,
+                                                              const std::string& destination,
+                                                              int64_t departAfter,
+                                                              int minConnection,
+                                                              int maxTravel) {
+    Itinerary result;
+
+    if (origin == destination) {
+        result.errorMessage = "Origin and destination are the same";
+        return result;
+    }
+    StopId source = timetable.getStopId(origin);
+    StopId target = timetable.getStopId(destination);
+    if (source == Timetable::INVALID_STOP) {
+        result.errorMessage = "No scheduled flights from " + origin;
+        return result;
+    }
+    if (target == Timetable::INVALID_STOP) {
+        result.errorMessage = "No scheduled flights to " + destination;
+        return result;
+    }
+
+    bool reached = scan(timetable, source, target, departAfter, minConnection, maxTravel);
+    result.connectionsScanned = scannedCount;
+    if (!reached) {
+        result.errorMessage = "No connection within " + std::to_string(maxTravel / 60) + " hours";
+        return result;
+    }
+
+    // Walk back ride by ride; each ride starts where an earlier one ended
+    const std::vector<Timetable::Connection>& connections = timetable.getConnections();
+    for (StopId stop = target; stop != source && result.legs.size() < timetable.getStopCount();) {
+        const Timetable::Connection& boarded = connections[enteredAt[stop]];
+        const Timetable::Connection& left = connections[exitedAt[stop]];
+        result.legs.push_back(Leg{timetable.getTripFlight(boarded.trip),
+                                  timetable.getStopCode(boarded.from),
+                                  timetable.getStopCode(left.to),
+                                  timetable.toEpochMinutes(boarded.departure),
+                                  timetable.toEpochMinutes(left.arrival)});
+        stop = boarded.from;
+    }
+    std::reverse(result.legs.begin(), result.legs.end());
+
+    result.found = true;
+    result.departure = result.legs.front().departure;
+    result.arrival = result.legs.back().arrival;
+    return result;
+}
+
+std::vector<std::string> ConnectionScan::Itinerary::getPath() const {
+    std::vector<std::string> path;
+    if (legs.empty()) {
+        return path;
+    }
+    path.push_back(legs.front().from);
+    for (const Leg& leg : legs) {
+        path.push_back(leg.to);
+    }
+    return path;
+}
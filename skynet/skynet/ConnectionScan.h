@@ -0,0 +1,113 @@
+#ifndef CONNECTIONSCAN_H
+#define CONNECTIONSCAN_H
+#include "Timetable.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Earliest-arrival itineraries over a Timetable (Connection Scan)
+ *
+ * Why connection scan?
+ * - Routing over the route graph minimizes km and ignores when flights
+ *   actually leave. Here the question is "leaving X after 09:00, when
+ *   can I be at Y?", answered from the booked schedule
+ * - Connections are sorted by departure, so one forward pass decides
+ *   the earliest arrival at every airport: a connection is usable if
+ *   its flight was already boarded or its airport was reached in time.
+ *   No priority queue, just a linear read of a flat array
+ * - The pass starts at the first connection after the requested time
+ *   (binary search) and stops once connections depart after the best
+ *   arrival at the destination, so a query touches only the hours in
+ *   between
+ *
+ * Connection times:
+ * - Changing flights needs minConnection minutes between landing and
+ *   the next departure; staying on the same flight through an
+ *   intermediate stop needs none
+ * - The scan gives up after maxTravel minutes past the requested
+ *   departure, which bounds queries with no answer
+ *
+ * Like SearchEngine, the engine keeps its per-airport and per-trip
+ * arrays between queries and resets them with a generation counter.
+ *
+ * Not thread-safe: use one engine per thread.
+ */
+class ConnectionScan {
+public:
+    using StopId = Timetable::StopId;
+
+    static constexpr int MIN_CONNECTION_MINUTES = 60;
+    static constexpr int MAX_TRAVEL_MINUTES = 2 * 24 * 60;
+
+    // One ride on one flight, possibly through intermediate stops
+    struct Leg {
+        std::string flightNumber;
+        std::string from;
+        std::string to;
+        int64_t departure;   // Epoch minutes (TimeUtil)
+        int64_t arrival;
+    };
+
+    struct Itinerary {
+        bool found;
+        std::vector<Leg> legs;
+        int64_t departure;   // First leg's departure, epoch minutes
+        int64_t arrival;     // Last leg's arrival
+        std::string errorMessage;
+        uint32_t connectionsScanned;
+
+        Itinerary() : found(false), departure(0), arrival(0), connectionsScanned(0) {}
+
+        int64_t getTravelMinutes() const { return arrival - departure; }
+        int getTransfers() const { return legs.empty() ? 0 : static_cast<int>(legs.size()) - 1; }
+
+        // Origin, the airports where flights change, destination
+        std::vector<std::string> getPath() const;
+    };
+
+    ConnectionScan();
+
+    /**
+     * Fastest itinerary leaving origin at or after departAfter
+     * @param departAfter Epoch minutes (TimeUtil::parseMinutes)
+     * @return Itinerary arriving earliest; among equal arrivals, the one
+     *         found first in departure order
+     */
+    Itinerary findEarliestArrival(const Timetable& timetable,
+                                  const std::string& origin,
+                                  const std::string& destination,
+                                  int64_t departAfter,
+                                  int minConnection = MIN_CONNECTION_MINUTES,
+                                  int maxTravel = MAX_TRAVEL_MINUTES);
+
+    /**
+     * Run the scan from origin until target's arrival is final
+     * @param target Timetable::INVALID_STOP scans the whole maxTravel window
+     * @return true if target was reached
+     */
+    bool scan(const Timetable& timetable, StopId origin, StopId target,
+              int64_t departAfter, int minConnection = MIN_CONNECTION_MINUTES,
+              int maxTravel = MAX_TRAVEL_MINUTES);
+
+    // Results of the last scan (valid until the next one)
+    bool isReached(StopId stop) const { return stamp[stop] == generation; }
+    int64_t getArrival(StopId stop) const;   // Epoch minutes
+    uint32_t getScannedCount() const { return scannedCount; }
+
+private:
+    void reset(const Timetable& timetable);
+
+    const Timetable* current;
+    std::vector<int64_t> arrival;   // Relative minutes
+    std::vector<int64_t> ready;     // Earliest departure from the stop
+    std::vector<uint32_t> enteredAt;   // Connection where the ride in was boarded
+    std::vector<uint32_t> exitedAt;    // Connection that arrived here
+    std::vector<uint32_t> stamp;
+    std::vector<uint32_t> tripBoardedAt;
+    std::vector<uint32_t> tripStamp;
+    uint32_t generation;
+    uint32_t scannedCount;
+};
+
+#endif // CONNECTIONSCAN_H
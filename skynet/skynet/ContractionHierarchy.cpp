@@ -0,0 +1,444 @@
+#include "ContractionHierarchy.h"
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+
+namespace {
+
+using NodeId = CompactGraph::NodeId;
+
+// Bound on witness search effort; a missed witness only adds a
+// redundant shortcut, never a wrong distance
+const uint32_t WITNESS_SETTLE_LIMIT = 500;
+
+struct BuildArc {
+    NodeId other;
+    double weight;
+    double cost;
+    NodeId middle;
+};
+
+/**
+ * Mutable state used only while contracting
+ */
+class Builder {
+public:
+    explicit Builder(const CompactGraph& g)
+        : nodeCount(g.getNodeCount()),
+          out(nodeCount), in(nodeCount),
+          contracted(nodeCount, false), deletedNeighbors(nodeCount, 0),
+          witnessDist(nodeCount), witnessStamp(nodeCount, 0), witnessGeneration(0),
+          shortcutCount(0) {
+        for (NodeId u = 0; u < nodeCount; ++u) {
+            for (uint32_t e = g.edgeBegin(u); e < g.edgeEnd(u); ++e) {
+                NodeId w = g.edgeTarget(e);
+                if (w != u) {
+                    addArc(u, w, g.edgeWeight(e), g.edgeCost(e), CompactGraph::INVALID_NODE);
+                }
+            }
+        }
+    }
+
+    // Contract all nodes; returns rank per node
+    std::vector<uint32_t> contractAll() {
+        using Entry = std::pair<int, NodeId>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+        for (NodeId v = 0; v < nodeCount; ++v) {
+            queue.push({priority(v), v});
+        }
+
+        std::vector<uint32_t> rank(nodeCount, 0);
+        uint32_t nextRank = 0;
+
+        while (!queue.empty()) {
+            NodeId v = queue.top().second;
+            queue.pop();
+            if (contracted[v]) continue;
+
+            // Lazy update: re-queue if priority went up since insertion
+            int current = priority(v);
+            if (!queue.empty() && current > queue.top().first) {
+                queue.push({current, v});
+                continue;
+            }
+
+            contract(v, true);
+            contracted[v] = true;
+            rank[v] = nextRank++;
+
+            // Detach v from its remaining neighbors; v keeps its own lists,
+            // which now hold exactly the arcs to higher-ranked nodes
+            for (const BuildArc& arc : out[v]) {
+                ++deletedNeighbors[arc.other];
+                removeArc(in[arc.other], v);
+            }
+            for (const BuildArc& arc : in[v]) {
+                ++deletedNeighbors[arc.other];
+                removeArc(out[arc.other], v);
+            }
+        }
+
+        return rank;
+    }
+
+    const std::vector<BuildArc>& outArcs(NodeId v) const { return out[v]; }
+    const std::vector<BuildArc>& inArcs(NodeId v) const { return in[v]; }
+    uint32_t getShortcutCount() const { return shortcutCount; }
+
+private:
+    static void removeArc(std::vector<BuildArc>& arcs, NodeId other) {
+        for (size_t i = 0; i < arcs.size(); ++i) {
+            if (arcs[i].other == other) {
+                arcs[i] = arcs.back();
+                arcs.pop_back();
+                return;
+            }
+        }
+    }
+
+    void addArc(NodeId u, NodeId w, double weight, double cost, NodeId middle) {
+        for (BuildArc& arc : out[u]) {
+            if (arc.other == w) {
+                if (weight < arc.weight) {
+                    arc = {w, weight, cost, middle};
+                    for (BuildArc& back : in[w]) {
+                        if (back.other == u) back = {u, weight, cost, middle};
+                    }
+                }
+                return;
+            }
+        }
+        out[u].push_back({w, weight, cost, middle});
+        in[w].push_back({u, weight, cost, middle});
+    }
+
+    // Bounded Dijkstra from source over uncontracted nodes, skipping one
+    void witnessSearch(NodeId source, NodeId skip, double maxDist) {
+        if (++witnessGeneration == 0) {
+            std::fill(witnessStamp.begin(), witnessStamp.end(), 0);
+            witnessGeneration = 1;
+        }
+
+        using Entry = std::pair<double, NodeId>;
+        witnessHeap.clear();
+        witnessDist[source] = 0.0;
+        witnessStamp[source] = witnessGeneration;
+        witnessHeap.push_back({0.0, source});
+
+        uint32_t settled = 0;
+        while (!witnessHeap.empty() && settled < WITNESS_SETTLE_LIMIT) {
+            std::pop_heap(witnessHeap.begin(), witnessHeap.end(), std::greater<Entry>());
+            auto [d, u] = witnessHeap.back();
+            witnessHeap.pop_back();
+
+            if (d > witnessDist[u]) continue;
+            if (d > maxDist) break;
+            ++settled;
+
+            for (const BuildArc& arc : out[u]) {
+                if (arc.other == skip) continue;
+                double nd = d + arc.weight;
+                if (witnessStamp[arc.other] != witnessGeneration || nd < witnessDist[arc.other]) {
+                    witnessDist[arc.other] = nd;
+                    witnessStamp[arc.other] = witnessGeneration;
+                    witnessHeap.push_back({nd, arc.other});
+                    std::push_heap(witnessHeap.begin(), witnessHeap.end(), std::greater<Entry>());
+                }
+            }
+        }
+    }
+
+    // Count (and optionally add) the shortcuts contracting v requires
+    int contract(NodeId v, bool apply) {
+        int shortcuts = 0;
+
+        // Lists of uncontracted nodes only reference uncontracted nodes
+        double maxOut = 0.0;
+        for (const BuildArc& arc : out[v]) {
+            maxOut = std::max(maxOut, arc.weight);
+        }
+
+        // Adding shortcuts never touches v's own lists
+        for (const BuildArc& inArc : in[v]) {
+            NodeId u = inArc.other;
+
+            witnessSearch(u, v, inArc.weight + maxOut);
+
+            for (const BuildArc& outArc : out[v]) {
+                NodeId w = outArc.other;
+                if (w == u) continue;
+
+                double via = inArc.weight + outArc.weight;
+                bool witnessed = witnessStamp[w] == witnessGeneration && witnessDist[w] <= via;
+                if (!witnessed) {
+                    ++shortcuts;
+                    if (apply) {
+                        addArc(u, w, via, inArc.cost + outArc.cost, v);
+                        ++shortcutCount;
+                    }
+                }
+            }
+        }
+
+        return shortcuts;
+    }
+
+    int priority(NodeId v) {
+        int degree = static_cast<int>(out[v].size() + in[v].size());
+        return contract(v, false) - degree + deletedNeighbors[v];
+    }
+
+    uint32_t nodeCount;
+    std::vector<std::vector<BuildArc>> out;
+    std::vector<std::vector<BuildArc>> in;
+    std::vector<bool> contracted;
+    std::vector<int> deletedNeighbors;
+
+    std::vector<double> witnessDist;
+    std::vector<uint32_t> witnessStamp;
+    uint32_t witnessGeneration;
+    std::vector<std::pair<double, NodeId>> witnessHeap;
+
+    uint32_t shortcutCount;
+};
+
+} // namespace
+
+// ==================== PREPROCESSING ====================
+
+ContractionHierarchy::ContractionHierarchy(std::shared_ptr<const CompactGraph> g)
+    : graph(std::move(g)), shortcutCount(0) {
+    const uint32_t nodeCount = graph->getNodeCount();
+
+    Builder builder(*graph);
+    rank = builder.contractAll();
+    shortcutCount = builder.getShortcutCount();
+
+    // After contraction each node's own lists hold exactly its arcs to
+    // higher-ranked nodes: out-arcs go up, in-arcs come down
+    upOffsets.assign(nodeCount + 1, 0);
+    downOffsets.assign(nodeCount + 1, 0);
+    for (NodeId v = 0; v < nodeCount; ++v) {
+        upOffsets[v + 1] = upOffsets[v] + static_cast<uint32_t>(builder.outArcs(v).size());
+        downOffsets[v + 1] = downOffsets[v] + static_cast<uint32_t>(builder.inArcs(v).size());
+    }
+
+    upArcs.reserve(upOffsets[nodeCount]);
+    downArcs.reserve(downOffsets[nodeCount]);
+    edges.reserve(upOffsets[nodeCount] + downOffsets[nodeCount]);
+
+    for (NodeId v = 0; v < nodeCount; ++v) {
+        for (const BuildArc& arc : builder.outArcs(v)) {
+            upArcs.push_back({arc.other, arc.weight, arc.cost});
+            edges[edgeKey(v, arc.other)] = {arc.weight, arc.cost, arc.middle};
+        }
+        for (const BuildArc& arc : builder.inArcs(v)) {
+            downArcs.push_back({arc.other, arc.weight, arc.cost});
+            edges[edgeKey(arc.other, v)] = {arc.weight, arc.cost, arc.middle};
+        }
+    }
+}
+
+void ContractionHierarchy::unpackEdge(NodeId from, NodeId to,
+                                      std::vector<NodeId>& path) const {
+    // Explicit stack: shortcut chains can be deep on large networks
+    std::vector<std::pair<NodeId, NodeId>> stack{{from, to}};
+
+    while (!stack.empty()) {
+        auto [a, b] = stack.back();
+        stack.pop_back();
+
+        const EdgeInfo& info = edges.at(edgeKey(a, b));
+        if (info.middle == CompactGraph::INVALID_NODE) {
+            path.push_back(b);
+        } else {
+            // Expand (a, middle) first, then (middle, b)
+            stack.push_back({info.middle, b});
+            stack.push_back({a, info.middle});
+        }
+    }
+}
+
+// ==================== QUERY ====================
+
+CHQuery::CHQuery()
+    : generation(0), settledCount(0),
+      meetingNode(CompactGraph::INVALID_NODE),
+      bestDistance(0.0), bestCost(0.0) {}
+
+void CHQuery::prepare(uint32_t nodeCount) {
+    for (int side = 0; side < 2; ++side) {
+        if (stamp[side].size() < nodeCount) {
+            dist[side].resize(nodeCount);
+            cost[side].resize(nodeCount);
+            parent[side].resize(nodeCount);
+            stamp[side].resize(nodeCount, 0);
+        }
+        heap[side].clear();
+    }
+
+    if (++generation == 0) {
+        std::fill(stamp[0].begin(), stamp[0].end(), 0);
+        std::fill(stamp[1].begin(), stamp[1].end(), 0);
+        generation = 1;
+    }
+
+    settledCount = 0;
+    meetingNode = CompactGraph::INVALID_NODE;
+}
+
+bool CHQuery::search(const ContractionHierarchy& ch, NodeId source, NodeId target) {
+    prepare(ch.getGraph()->getNodeCount());
+
+    const double INF = std::numeric_limits<double>::infinity();
+    bestDistance = INF;
+    bestCost = 0.0;
+
+    const NodeId roots[2] = {source, target};
+    for (int side = 0; side < 2; ++side) {
+        dist[side][roots[side]] = 0.0;
+        cost[side][roots[side]] = 0.0;
+        parent[side][roots[side]] = CompactGraph::INVALID_NODE;
+        stamp[side][roots[side]] = generation;
+        heap[side].push_back({0.0, roots[side]});
+    }
+
+    // Side 0 climbs up-arcs from the source, side 1 down-arcs from the target
+    int side = 0;
+    while (!heap[0].empty() || !heap[1].empty()) {
+        if (heap[side].empty()) {
+            side = 1 - side;
+        }
+        auto& h = heap[side];
+
+        std::pop_heap(h.begin(), h.end(), std::greater<HeapEntry>());
+        HeapEntry top = h.back();
+        h.pop_back();
+
+        NodeId u = top.node;
+        if (top.key > dist[side][u]) {
+            side = 1 - side;
+            continue;
+        }
+
+        // Upward paths only get longer: this side is done
+        if (top.key >= bestDistance) {
+            h.clear();
+            side = 1 - side;
+            continue;
+        }
+        ++settledCount;
+
+        const int other = 1 - side;
+        if (stamp[other][u] == generation && top.key + dist[other][u] < bestDistance) {
+            bestDistance = top.key + dist[other][u];
+            bestCost = cost[side][u] + cost[other][u];
+            meetingNode = u;
+        }
+
+        // Stall-on-demand: if a higher node reaches u more cheaply via an
+        // arc of the opposite direction, u is not on a shortest up-path
+        bool stalled = false;
+        uint32_t stallBegin = (side == 0) ? ch.downBegin(u) : ch.upBegin(u);
+        uint32_t stallEnd = (side == 0) ? ch.downEnd(u) : ch.upEnd(u);
+        for (uint32_t i = stallBegin; i < stallEnd && !stalled; ++i) {
+            const ContractionHierarchy::Arc& arc = (side == 0) ? ch.downArc(i) : ch.upArc(i);
+            stalled = stamp[side][arc.head] == generation &&
+                      dist[side][arc.head] + arc.weight < top.key;
+        }
+        if (stalled) {
+            side = other;
+            continue;
+        }
+
+        uint32_t begin = (side == 0) ? ch.upBegin(u) : ch.downBegin(u);
+        uint32_t end = (side == 0) ? ch.upEnd(u) : ch.downEnd(u);
+        for (uint32_t i = begin; i < end; ++i) {
+            const ContractionHierarchy::Arc& arc = (side == 0) ? ch.upArc(i) : ch.downArc(i);
+            double nd = top.key + arc.weight;
+
+            if (stamp[side][arc.head] != generation || nd < dist[side][arc.head]) {
+                dist[side][arc.head] = nd;
+                cost[side][arc.head] = cost[side][u] + arc.cost;
+                parent[side][arc.head] = u;
+                stamp[side][arc.head] = generation;
+                h.push_back({nd, arc.head});
+                std::push_heap(h.begin(), h.end(), std::greater<HeapEntry>());
+            }
+        }
+
+        side = other;
+    }
+
+    return meetingNode != CompactGraph::INVALID_NODE;
+}
+
+PathResult CHQuery::findShortestPath(const ContractionHierarchy& ch,
+                                     const std::string& start,
+                                     const std::string& end) {
+    const CompactGraph& graph = *ch.getGraph();
+    NodeId source = graph.getNodeId(start);
+    NodeId target = graph.getNodeId(end);
+
+    // Validate inputs
+    if (source == CompactGraph::INVALID_NODE) {
+        PathResult result;
+        result.found = false;
+        result.errorMessage = "Origin airport not found";
+        return result;
+    }
+
+    if (target == CompactGraph::INVALID_NODE) {
+        PathResult result;
+        result.found = false;
+        result.errorMessage = "Destination airport not found";
+        return result;
+    }
+
+    if (source == target) {
+        PathResult result;
+        result.found = true;
+        result.path = {start};
+        result.totalDistance = 0.0;
+        result.totalCost = 0.0;
+        return result;
+    }
+
+    if (!search(ch, source, target)) {
+        PathResult result;
+        result.found = false;
+        result.errorMessage = "No route available between airports";
+        result.nodesExpanded = static_cast<int>(settledCount);
+        return result;
+    }
+
+    // Hierarchy path: source ... meeting node ... target
+    pathScratch.clear();
+    for (NodeId v = meetingNode; v != CompactGraph::INVALID_NODE; v = parent[0][v]) {
+        pathScratch.push_back(v);
+    }
+    std::reverse(pathScratch.begin(), pathScratch.end());
+    for (NodeId v = parent[1][meetingNode]; v != CompactGraph::INVALID_NODE; v = parent[1][v]) {
+        pathScratch.push_back(v);
+    }
+
+    // Expand shortcuts back to original airports
+    unpacked.clear();
+    unpacked.push_back(pathScratch.front());
+    for (size_t i = 0; i + 1 < pathScratch.size(); ++i) {
+        ch.unpackEdge(pathScratch[i], pathScratch[i + 1], unpacked);
+    }
+
+    PathResult result;
+    result.found = true;
+    result.path.reserve(unpacked.size());
+    for (NodeId v : unpacked) {
+        result.path.push_back(graph.getNodeCode(v));
+    }
+    result.totalDistance = bestDistance;
+    result.totalCost = bestCost;
+    result.nodesExpanded = static_cast<int>(settledCount);
+
+    return result;
+}
@@ -0,0 +1,148 @@
+#ifndef CONTRACTIONHIERARCHY_H
+#define CONTRACTIONHIERARCHY_H
+#include "CompactGraph.h"
+#include "PathResult.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Contraction Hierarchies (CH) preprocessing for fast shortest paths
+ *
+ * Why CH?
+ * - Dijkstra/A* explore a large part of the network on every query
+ * - CH pays once up front: nodes are contracted in importance order and
+ *   shortcut edges preserve shortest distances among the remaining nodes
+ * - A query then only climbs "upward" (to more important nodes) from both
+ *   ends, settling a few dozen nodes even on large networks
+ *
+ * Preprocessing:
+ * 1. Order nodes by edge difference (shortcuts added - edges removed)
+ *    plus contracted-neighbor count, updated lazily
+ * 2. Contract each node: for every in/out neighbor pair (u, w) add a
+ *    shortcut u->w unless a bounded witness search finds a path that is
+ *    no longer without the node
+ * 3. Split all edges into upward-forward and upward-backward CSR graphs
+ *
+ * Each shortcut remembers its middle node, so query results are unpacked
+ * back to the original airport sequence.
+ *
+ * Immutable once built and tied to the CompactGraph it was built from;
+ * DataStore drops it whenever the graph changes.
+ */
+class ContractionHierarchy {
+public:
+    using NodeId = CompactGraph::NodeId;
+
+    explicit ContractionHierarchy(std::shared_ptr<const CompactGraph> graph);
+
+    // Snapshot this hierarchy was built from (staleness check)
+    const std::shared_ptr<const CompactGraph>& getGraph() const { return graph; }
+
+    uint32_t getShortcutCount() const { return shortcutCount; }
+    uint32_t getRank(NodeId v) const { return rank[v]; }
+
+    // Upward CSR access for query engines
+    uint32_t upBegin(NodeId v) const { return upOffsets[v]; }
+    uint32_t upEnd(NodeId v) const { return upOffsets[v + 1]; }
+    uint32_t downBegin(NodeId v) const { return downOffsets[v]; }
+    uint32_t downEnd(NodeId v) const { return downOffsets[v + 1]; }
+
+    struct Arc {
+        NodeId head;     // Higher-ranked endpoint
+        double weight;   // Distance in km
+        double cost;     // Operational cost
+    };
+    const Arc& upArc(uint32_t i) const { return upArcs[i]; }
+    const Arc& downArc(uint32_t i) const { return downArcs[i]; }
+
+    /**
+     * Append the original nodes of edge (from -> to) after from,
+     * recursively expanding shortcuts
+     */
+    void unpackEdge(NodeId from, NodeId to, std::vector<NodeId>& path) const;
+
+private:
+    struct EdgeInfo {
+        double weight;
+        double cost;
+        NodeId middle;   // INVALID_NODE for original edges
+    };
+
+    static uint64_t edgeKey(NodeId from, NodeId to) {
+        return (static_cast<uint64_t>(from) << 32) | to;
+    }
+
+    std::shared_ptr<const CompactGraph> graph;
+    std::vector<uint32_t> rank;   // Contraction order
+    uint32_t shortcutCount;
+
+    // Forward search climbs upArcs; backward search climbs downArcs
+    // (reversed edges u->v stored at v with head u, rank[u] > rank[v])
+    std::vector<uint32_t> upOffsets;
+    std::vector<Arc> upArcs;
+    std::vector<uint32_t> downOffsets;
+    std::vector<Arc> downArcs;
+
+    // Every edge and shortcut, for unpacking
+    std::unordered_map<uint64_t, EdgeInfo> edges;
+};
+
+/**
+ * @brief Reusable query workspace for a ContractionHierarchy
+ *
+ * Same generation-stamped dense arrays as SearchEngine, so repeated
+ * queries make no heap allocations inside the search.
+ * Not thread-safe: use one per thread.
+ */
+class CHQuery {
+public:
+    using NodeId = CompactGraph::NodeId;
+
+    CHQuery();
+
+    /**
+     * Find shortest path between two airports
+     * @return Fully unpacked PathResult (same distance/cost as Dijkstra)
+     */
+    PathResult findShortestPath(const ContractionHierarchy& ch,
+                                const std::string& start,
+                                const std::string& end);
+
+    /**
+     * Distance-only query between node ids
+     * @return true if target is reachable
+     */
+    bool search(const ContractionHierarchy& ch, NodeId source, NodeId target);
+
+    double getDistance() const { return bestDistance; }
+    double getCost() const { return bestCost; }
+
+private:
+    struct HeapEntry {
+        double key;
+        NodeId node;
+        bool operator>(const HeapEntry& other) const { return key > other.key; }
+    };
+
+    void prepare(uint32_t nodeCount);
+
+    std::vector<double> dist[2];
+    std::vector<double> cost[2];
+    std::vector<NodeId> parent[2];
+    std::vector<uint32_t> stamp[2];
+    std::vector<HeapEntry> heap[2];
+    uint32_t generation;
+    uint32_t settledCount;
+
+    NodeId meetingNode;
+    double bestDistance;
+    double bestCost;
+
+    std::vector<NodeId> pathScratch;
+    std::vector<NodeId> unpacked;
+};
+
+#endif // CONTRACTIONHIERARCHY_H
@@ -0,0 +1,100 @@
+#include "CsvReader.h"
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+
+CsvReader::CsvReader() : pos(0), lineNumber(0) {}
+
+CsvReader::CsvReader(std::string_view text, int firstLineNumber)
+    : text(text), pos(0), lineNumber(firstLineNumber - 1) {}
+
+bool CsvReader::open(const std::string& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    // One read into one buffer
+    std::streamsize size = file.tellg();
+    file.seekg(0, std::ios::beg);
+    buffer.resize(size > 0 ? static_cast<size_t>(size) : 0);
+    if (size > 0 && !file.read(&buffer[0], size)) {
+        return false;
+    }
+
+    text = buffer;
+    pos = 0;
+    lineNumber = 0;
+    return true;
+}
+
+bool CsvReader::next() {
+    while (pos < text.size()) {
+        size_t end = text.find('\n', pos);
+        if (end == std::string_view::npos) end = text.size();
+
+        line = text.substr(pos, end - pos);
+        pos = end + 1;
+        ++lineNumber;
+
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        if (trim(line).empty()) {
+            continue;
+        }
+
+        fields.clear();
+        size_t start = 0;
+        while (true) {
+            size_t comma = line.find(',', start);
+            if (comma == std::string_view::npos) {
+                fields.push_back(trim(line.substr(start)));
+                break;
+            }
+            fields.push_back(trim(line.substr(start, comma - start)));
+            start = comma + 1;
+        }
+        return true;
+    }
+
+    line = std::string_view();
+    fields.clear();
+    return false;
+}
+
+std::vector<size_t> CsvReader::chunkBounds(std::string_view text, size_t chunkCount) {
+    std::vector<size_t> bounds{0};
+    for (size_t k = 1; k < chunkCount; ++k) {
+        size_t target = std::max(bounds.back(), k * (text.size() / chunkCount));
+        size_t cut = text.find('\n', target);
+        if (cut == std::string_view::npos || cut + 1 >= text.size()) break;
+        bounds.push_back(cut + 1);
+    }
+    bounds.push_back(text.size());
+    return bounds;
+}
+
+std::string_view CsvReader::trim(std::string_view s) {
+    const char* whitespace = " \t\r\n";
+    size_t first = s.find_first_not_of(whitespace);
+    if (first == std::string_view::npos) return std::string_view();
+
+    size_t last = s.find_last_not_of(whitespace);
+    return s.substr(first, last - first + 1);
+}
+
+bool CsvReader::toDouble(std::string_view s, double& out) {
+    // from_chars rejects a leading '+', which stod accepted
+    if (!s.empty() && s.front() == '+') s.remove_prefix(1);
+
+    auto result = std::from_chars(s.data(), s.data() + s.size(), out);
+    return result.ec == std::errc() && result.ptr == s.data() + s.size() && !s.empty();
+}
+
+bool CsvReader::toInt(std::string_view s, int& out) {
+    if (!s.empty() && s.front() == '+') s.remove_prefix(1);
+
+    auto result = std::from_chars(s.data(), s.data() + s.size(), out);
+    return result.ec == std::errc() && result.ptr == s.data() + s.size() && !s.empty();
+}
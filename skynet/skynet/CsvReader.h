@@ -0,0 +1,81 @@
+#ifndef CSVREADER_H
+#define CSVREADER_H
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief In-place CSV tokenizer for the data_files loaders
+ *
+ * Why not getline + split + stod?
+ * - split() built a std::vector<std::string> per line, trim() copied
+ *   every field again and stod() needed yet another std::string
+ * - The reader loads the whole file into one buffer and hands out
+ *   std::string_view fields pointing into it; the field vector is
+ *   reused, so tokenizing allocates nothing after the first line
+ * - Numbers go through std::from_chars: no locale, no exceptions, no
+ *   copies, and the whole field must be consumed
+ *
+ * Format: comma-separated, one record per line, no quoting (matches
+ * what DataStore writes). LF and CRLF line endings are accepted; blank
+ * lines are skipped. Line numbers are 1-based for error messages.
+ *
+ * Usage:
+ *   CsvReader csv;
+ *   if (csv.open(path)) {
+ *       csv.next();                      // header
+ *       while (csv.next()) { ... csv.field(0) ... }
+ *   }
+ */
+class CsvReader {
+public:
+    CsvReader();
+
+    // Tokenize text owned by the caller (must outlive the reader)
+    explicit CsvReader(std::string_view text, int firstLineNumber = 1);
+
+    /**
+     * Read a whole file into the reader's buffer
+     * @return false if the file cannot be opened
+     */
+    bool open(const std::string& path);
+
+    /**
+     * Advance to the next non-blank line and split it into fields
+     * @return false at end of input
+     */
+    bool next();
+
+    size_t getFieldCount() const { return fields.size(); }
+    std::string_view field(size_t i) const { return fields[i]; }   // Trimmed
+    std::string fieldString(size_t i) const { return std::string(fields[i]); }
+    bool parseDouble(size_t i, double& out) const { return toDouble(fields[i], out); }
+    bool parseInt(size_t i, int& out) const { return toInt(fields[i], out); }
+
+    int getLineNumber() const { return lineNumber; }
+    std::string_view getLine() const { return line; }
+    std::string_view getText() const { return text; }
+
+    /**
+     * Cut text into at most chunkCount pieces of similar size, each
+     * starting at the beginning of a line (for parallel parsing)
+     * @return Offsets b[0] = 0 < ... < b[n] = text.size(); piece k is
+     *         [b[k], b[k + 1])
+     */
+    static std::vector<size_t> chunkBounds(std::string_view text, size_t chunkCount);
+
+    // Field helpers, usable on any string_view
+    static std::string_view trim(std::string_view s);
+    static bool toDouble(std::string_view s, double& out);
+    static bool toInt(std::string_view s, int& out);
+
+private:
+    std::string buffer;   // Owned file contents (empty for caller text)
+    std::string_view text;
+    size_t pos;
+    int lineNumber;
+    std::string_view line;
+    std::vector<std::string_view> fields;
+};
+
+#endif // CSVREADER_H
@@ -1,31 +1,221 @@
 #include "DataStore.h"
 #include "Haversine.h"
-#include <fstream>
-#include <sstream>  // CRITICAL: Required for flight parsing
-//#include <algorithm>
+#include "CsvReader.h"
+#include "BinaryStore.h"
+#include "AtomicFileWriter.h"
+#include "Scheduling.h"
+#include <sstream>
+#include <algorithm>
 #include <iostream>
 #include <filesystem>
+#include <future>
+#include <thread>
+
+namespace {
+
+// One CSV row per entity, shared by the CSV files and the journal
+
+void writeAirportRow(std::ostream& out, const Airport& airport) {
+    out << airport.code << ","
+        << airport.name << ","
+        << airport.city << ","
+        << airport.country << ","
+        << airport.latitude << ","
+        << airport.longitude;
+}
+
+void writeAircraftRow(std::ostream& out, const Aircraft& ac) {
+    out << ac.id << ","
+        << ac.model << ","
+        << ac.capacity << ","
+        << ac.cruiseSpeed << ","
+        << ac.fuelConsumption << ","
+        << Aircraft::statusToString(ac.status);
+}
+
+void writeRouteRow(std::ostream& out, const Route& route) {
+    out << route.origin << ","
+        << route.destination << ","
+        << route.distance << ","
+        << route.baseCost << ","
+        << (route.operational ? "1" : "0");
+}
+
+void writeFlightRow(std::ostream& out, const Flight& flight) {
+    out << flight.flightNumber << ",";
+    out << flight.aircraftId << ",";
+
+    // Write route as: JFK-LHR-DXB
+    for (size_t i = 0; i < flight.route.size(); ++i) {
+        out << flight.route[i];
+        if (i < flight.route.size() - 1) {
+            out << "-";
+        }
+    }
+    out << ",";
+
+    out << flight.totalDistance << ",";
+    out << flight.totalCost << ",";
+    out << flight.estimatedTime << ",";
+    out << flight.departureTime << ",";
+    out << flight.status;
+}
+
+// Row parsers read the fields starting at column first; false if the row
+// is short or a number does not parse
+
+bool parseAirportRow(const CsvReader& csv, size_t first, Airport& airport) {
+    if (csv.getFieldCount() < first + 6 ||
+        !csv.parseDouble(first + 4, airport.latitude) ||
+        !csv.parseDouble(first + 5, airport.longitude)) {
+        return false;
+    }
+    airport.code = csv.fieldString(first);
+    airport.name = csv.fieldString(first + 1);
+    airport.city = csv.fieldString(first + 2);
+    airport.country = csv.fieldString(first + 3);
+    return true;
+}
+
+bool parseAircraftRow(const CsvReader& csv, size_t first, Aircraft& ac) {
+    if (csv.getFieldCount() < first + 6 ||
+        !csv.parseInt(first + 2, ac.capacity) ||
+        !csv.parseDouble(first + 3, ac.cruiseSpeed) ||
+        !csv.parseDouble(first + 4, ac.fuelConsumption)) {
+        return false;
+    }
+    ac.id = csv.fieldString(first);
+    ac.model = csv.fieldString(first + 1);
+    ac.status = Aircraft::stringToStatus(csv.fieldString(first + 5));
+    return true;
+}
+
+bool parseRouteRow(const CsvReader& csv, size_t first, Route& route) {
+    if (csv.getFieldCount() < first + 5 ||
+        !csv.parseDouble(first + 2, route.distance) ||
+        !csv.parseDouble(first + 3, route.baseCost)) {
+        return false;
+    }
+    route.origin = csv.fieldString(first);
+    route.destination = csv.fieldString(first + 1);
+    route.operational = (csv.field(first + 4) == "1" || csv.field(first + 4) == "true");
+    return true;
+}
+
+bool parseFlightRow(const CsvReader& csv, size_t first, Flight& flight) {
+    if (csv.getFieldCount() < first + 8 ||
+        !csv.parseDouble(first + 3, flight.totalDistance) ||
+        !csv.parseDouble(first + 4, flight.totalCost) ||
+        !csv.parseDouble(first + 5, flight.estimatedTime)) {
+        return false;
+    }
+    flight.flightNumber = csv.fieldString(first);
+    flight.aircraftId = csv.fieldString(first + 1);
+
+    // Parse route (format: JFK-LHR-DXB)
+    std::string_view routeStr = csv.field(first + 2);
+    while (!routeStr.empty()) {
+        size_t dash = routeStr.find('-');
+        flight.route.emplace_back(CsvReader::trim(routeStr.substr(0, dash)));
+        if (dash == std::string_view::npos) break;
+        routeStr.remove_prefix(dash + 1);
+    }
+
+    flight.departureTime = csv.fieldString(first + 6);
+    flight.status = csv.fieldString(first + 7);
+    return true;
+}
+
+// Journal record tags
+const char* const PUT_AIRPORT = "PUT_AIRPORT";
+const char* const DEL_AIRPORT = "DEL_AIRPORT";
+const char* const PUT_AIRCRAFT = "PUT_AIRCRAFT";
+const char* const DEL_AIRCRAFT = "DEL_AIRCRAFT";
+const char* const PUT_ROUTE = "PUT_ROUTE";
+const char* const DEL_ROUTE = "DEL_ROUTE";
+const char* const PUT_FLIGHT = "PUT_FLIGHT";
+const char* const DEL_FLIGHT = "DEL_FLIGHT";
+
+// Copy the matches in [offset, offset + limit) of key order and count
+// all of them
+template <typename T, typename Match>
+Page<T> collectPage(const EntityTable<T>& table, size_t offset, size_t limit, Match matches) {
+    Page<T> page;
+    page.offset = offset;
+    for (const T* record : table.valuesByKey()) {
+        if (!matches(*record)) continue;
+        if (page.total >= offset && page.items.size() < limit) {
+            page.items.push_back(*record);
+        }
+        ++page.total;
+    }
+    return page;
+}
+
+} // namespace
 
 DataStore& DataStore::getInstance() {
     static DataStore instance;
     return instance;
 }
 
-DataStore::DataStore() {}
+DataStore::DataStore()
+    : flightIndexValid(false), workingGraphValid(true), graphDirty(false),
+    graphSnapshot(std::make_shared<GraphSnapshot>(0, std::make_shared<CompactGraph>())),
+    graphVersion(0),
+    bulkDepth(0), bulkChangeCount(0), bulkGraphStale(false), bulkSavePending(false) {}
 
 bool DataStore::loadAll() {
     try {
         std::filesystem::create_directories("data_files");
 
+        // Reloading: finish saves and get queued records on disk before
+        // reading them back
+        persistence.waitIdle();
+        journal.close();
+        flightIndexValid = false;
+        flightIndex.clear();
+        scheduler.clear();
+        timetable.reset();
+
+        // Binary image is a cache of the CSVs: use it while it is current
+        bool fromImage = isBinaryCurrent() && loadBinary();
         bool success = true;
-        success &= loadAirports();
-        success &= loadAircraft();
-        success &= loadRoutes();
-        success &= loadFlights();
+
+        if (!fromImage) {
+            // Independent until the graph is built: load all four at once
+            LoadLog logs[4];
+            auto airportsLoaded = std::async(std::launch::async, [&]() { return loadAirports(logs[0]); });
+            auto aircraftLoaded = std::async(std::launch::async, [&]() { return loadAircraft(logs[1]); });
+            auto routesLoaded = std::async(std::launch::async, [&]() { return loadRoutes(logs[2]); });
+            success = loadFlights(logs[3]);   // Fans out into chunks itself
+            success &= airportsLoaded.get();
+            success &= aircraftLoaded.get();
+            success &= routesLoaded.get();
+
+            for (const auto& log : logs) {
+                std::cerr << log.errors.str();
+                std::cout << log.info.str();
+            }
+        }
 
         if (success) {
-            rebuildGraph();
-            std::cout << "✓ All data loaded successfully" << std::endl;
+            // Edits made after the base files were last written
+            uint64_t replayed = replayJournal();
+
+            if (!fromImage || replayed > 0) {
+                rebuildGraph();
+            }
+            if (!fromImage) {
+                saveBinary(airports, aircraft, routes, flights, *getCompactGraph());
+            }
+            std::cout << "✓ All data loaded successfully"
+                      << (fromImage ? " (binary image)" : "") << std::endl;
+        }
+
+        if (!journal.open(JOURNAL_FILE)) {
+            std::cerr << "⚠ Could not open " << JOURNAL_FILE
+                      << ", edits will be saved by rewriting the data files" << std::endl;
         }
 
         return success;
@@ -36,12 +226,63 @@ bool DataStore::loadAll() {
 }
 
 bool DataStore::saveAll() {
+    if (bulkDepth > 0) {
+        bulkSavePending = true;
+        return true;
+    }
+
+    // This thread waits for the write, so the live containers cannot
+    // change under it: no copy needed
+    std::shared_ptr<const CompactGraph> graph = getCompactGraph();
+    uint64_t journalMark = journal.getLastSequence();
+    return persistence.run([&]() {
+        return writeBaseFiles(airports, aircraft, routes, flights, *graph, journalMark);
+    });
+}
+
+void DataStore::saveAllAsync(SaveCallback done) {
+    if (bulkDepth > 0) {
+        bulkSavePending = true;
+        if (done) bulkSaveCallbacks.push_back(std::move(done));
+        return;
+    }
+
+    // The copy is the only part that runs on the calling thread
+    auto snapshot = std::make_shared<SaveSnapshot>();
+    snapshot->airports = airports;
+    snapshot->aircraft = aircraft;
+    snapshot->routes = routes;
+    snapshot->flights = flights;
+    snapshot->graph = getCompactGraph();
+    snapshot->journalMark = journal.getLastSequence();
+
+    persistence.submit([this, snapshot]() {
+        return writeBaseFiles(snapshot->airports, snapshot->aircraft, snapshot->routes,
+                              snapshot->flights, *snapshot->graph, snapshot->journalMark);
+    }, std::move(done));
+}
+
+bool DataStore::writeBaseFiles(const EntityTable<Airport>& airportData,
+                               const EntityTable<Aircraft>& aircraftData,
+                               const EntityTable<Route>& routeData,
+                               const EntityTable<Flight>& flightData,
+                               const CompactGraph& graph, uint64_t journalMark) {
     try {
         bool success = true;
-        success &= saveAirports();
-        success &= saveAircraft();
-        success &= saveRoutes();
-        success &= saveFlights();
+        success &= saveAirports(airportData);
+        success &= saveAircraft(aircraftData);
+        success &= saveRoutes(routeData);
+        success &= saveFlights(flightData);
+
+        // Written last so it is newer than the CSVs it mirrors
+        if (success) {
+            saveBinary(airportData, aircraftData, routeData, flightData, graph);
+        }
+
+        // Base files now hold every edit journaled up to the mark
+        if (success && journal.isOpen()) {
+            success = journal.compact(journalMark);
+        }
 
         if (success) {
             std::cout << "✓ All data saved successfully" << std::endl;
@@ -54,6 +295,73 @@ bool DataStore::saveAll() {
     }
 }
 
+bool DataStore::syncJournal() {
+    if (!journal.isOpen()) {
+        return saveAll();
+    }
+    bool durable = journal.sync();
+
+    // Fold a long journal into the base files without blocking the caller
+    if (journal.getRecordCount() >= COMPACT_AFTER_RECORDS && !persistence.isBusy()) {
+        saveAllAsync();
+    }
+    return durable;
+}
+
+bool DataStore::compactJournal() {
+    persistence.waitIdle();
+    if (!journal.isOpen() || journal.getRecordCount() == 0) {
+        return true;
+    }
+    return saveAll();
+}
+
+// ==================== BULK TRANSACTIONS ====================
+
+void DataStore::beginBulk() {
+    ++bulkDepth;
+}
+
+void DataStore::commitBulk() {
+    if (bulkDepth == 0 || --bulkDepth > 0) {
+        return;
+    }
+
+    // Apply everything the transaction deferred, once
+    if (bulkGraphStale) {
+        bulkGraphStale = false;
+        rebuildGraph();
+    }
+    if (bulkChangeCount > 0) {
+        pushUndo(Action(ActionType::BULK_CHANGE, std::to_string(bulkChangeCount)));
+        bulkChangeCount = 0;
+    }
+    if (bulkSavePending) {
+        bulkSavePending = false;
+        std::vector<SaveCallback> callbacks;
+        callbacks.swap(bulkSaveCallbacks);
+        saveAllAsync([callbacks](bool success) {
+            for (const SaveCallback& callback : callbacks) callback(success);
+        });
+    }
+}
+
+void DataStore::recordChange(const Action& action) {
+    if (bulkDepth > 0) {
+        ++bulkChangeCount;
+    } else {
+        pushUndo(action);
+    }
+}
+
+bool DataStore::deferGraphEdit() {
+    if (bulkDepth == 0) {
+        return false;
+    }
+    bulkGraphStale = true;
+    return true;
+}
+
 // ==================== AIRPORT CRUD ====================
 
 bool DataStore::addAirport(const Airport& airport) {
@@ -62,8 +370,16 @@ bool DataStore::addAirport(const Airport& airport) {
     }
 
     airports[airport.code] = airport;
-    pushUndo(Action(ActionType::ADD_AIRPORT, serializeAirport(airport)));
-    rebuildGraph();
+    recordChange(Action(ActionType::ADD_AIRPORT, serializeAirport(airport)));
+    journalPut(airport);
+    timetable.reset();   // Leg times are split by airport coordinates
+
+    if (deferGraphEdit()) return true;
+    std::lock_guard<std::mutex> lock(graphMutex);
+    ensureWorkingGraph();
+    workingGraph.addNode(airport.code);
+    nodeCoordinates[airport.code] = {airport.latitude, airport.longitude};
+    graphDirty = true;
     return true;
 }
 
@@ -73,21 +389,32 @@ bool DataStore::deleteAirport(const std::string& code) {
         return false;
     }
 
-    pushUndo(Action(ActionType::DELETE_AIRPORT, serializeAirport(it->second)));
+    recordChange(Action(ActionType::DELETE_AIRPORT, serializeAirport(it->second)));
 
     // Remove all routes involving this airport
-    std::vector<std::string> routesToDelete;
+    std::vector<Route> routesToDelete;
     for (const auto& [id, route] : routes) {
         if (route.origin == code || route.destination == code) {
-            routesToDelete.push_back(id);
+            routesToDelete.push_back(route);
         }
     }
-    for (const auto& id : routesToDelete) {
-        routes.erase(id);
+    for (const auto& route : routesToDelete) {
+        routes.erase(route.getId());
     }
 
     airports.erase(it);
-    rebuildGraph();
+    journalDelete(DEL_AIRPORT, code);   // Replay drops the routes too
+    timetable.reset();
+
+    if (deferGraphEdit()) return true;
+    std::lock_guard<std::mutex> lock(graphMutex);
+    ensureWorkingGraph();
+    for (const auto& route : routesToDelete) {
+        refreshRouteEdges(route.origin, route.destination);
+    }
+    workingGraph.removeNode(code);
+    nodeCoordinates.erase(code);
+    graphDirty = true;
     return true;
 }
 
@@ -97,7 +424,15 @@ bool DataStore::updateAirport(const Airport& airport) {
     }
 
     airports[airport.code] = airport;
-    rebuildGraph();
+    journalPut(airport);
+    timetable.reset();
+
+    // Topology is unchanged; only the A* coordinates move
+    if (deferGraphEdit()) return true;
+    std::lock_guard<std::mutex> lock(graphMutex);
+    ensureWorkingGraph();
+    nodeCoordinates[airport.code] = {airport.latitude, airport.longitude};
+    graphDirty = true;
     return true;
 }
 
@@ -108,8 +443,9 @@ Airport* DataStore::getAirport(const std::string& code) {
 
 std::vector<Airport> DataStore::getAllAirports() const {
     std::vector<Airport> result;
-    for (const auto& pair : airports) {
-        result.push_back(pair.second);
+    result.reserve(airports.size());
+    for (const auto* record : airports.valuesByKey()) {
+        result.push_back(*record);
     }
     return result;
 }
@@ -122,7 +458,8 @@ bool DataStore::addAircraft(const Aircraft& ac) {
     }
 
     aircraft[ac.id] = ac;
-    pushUndo(Action(ActionType::ADD_AIRCRAFT, ac.id));
+    recordChange(Action(ActionType::ADD_AIRCRAFT, ac.id));
+    journalPut(ac);
     return true;
 }
 
@@ -132,8 +469,9 @@ bool DataStore::deleteAircraft(const std::string& id) {
         return false;
     }
 
-    pushUndo(Action(ActionType::DELETE_AIRCRAFT, id));
+    recordChange(Action(ActionType::DELETE_AIRCRAFT, id));
     aircraft.erase(it);
+    journalDelete(DEL_AIRCRAFT, id);
     return true;
 }
 
@@ -143,6 +481,7 @@ bool DataStore::updateAircraft(const Aircraft& ac) {
     }
 
     aircraft[ac.id] = ac;
+    journalPut(ac);
     return true;
 }
 
@@ -153,8 +492,9 @@ Aircraft* DataStore::getAircraft(const std::string& id) {
 
 std::vector<Aircraft> DataStore::getAllAircraft() const {
     std::vector<Aircraft> result;
-    for (const auto& pair : aircraft) {
-        result.push_back(pair.second);
+    result.reserve(aircraft.size());
+    for (const auto* record : aircraft.valuesByKey()) {
+        result.push_back(*record);
     }
     return result;
 }
@@ -168,8 +508,14 @@ bool DataStore::addRoute(const Route& route) {
     }
 
     routes[id] = route;
-    pushUndo(Action(ActionType::ADD_ROUTE, id));
-    rebuildGraph();
+    recordChange(Action(ActionType::ADD_ROUTE, id));
+    journalPut(route);
+
+    if (deferGraphEdit()) return true;
+    std::lock_guard<std::mutex> lock(graphMutex);
+    ensureWorkingGraph();
+    refreshRouteEdges(route.origin, route.destination);
+    graphDirty = true;
     return true;
 }
 
@@ -179,9 +525,16 @@ bool DataStore::deleteRoute(const std::string& routeId) {
         return false;
     }
 
-    pushUndo(Action(ActionType::DELETE_ROUTE, routeId));
+    recordChange(Action(ActionType::DELETE_ROUTE, routeId));
+    Route removed = it->second;
     routes.erase(it);
-    rebuildGraph();
+    journalDelete(DEL_ROUTE, routeId);
+
+    if (deferGraphEdit()) return true;
+    std::lock_guard<std::mutex> lock(graphMutex);
+    ensureWorkingGraph();
+    refreshRouteEdges(removed.origin, removed.destination);
+    graphDirty = true;
     return true;
 }
 
@@ -192,7 +545,13 @@ bool DataStore::updateRoute(const Route& route) {
     }
 
     routes[id] = route;
-    rebuildGraph();
+    journalPut(route);
+
+    if (deferGraphEdit()) return true;
+    std::lock_guard<std::mutex> lock(graphMutex);
+    ensureWorkingGraph();
+    refreshRouteEdges(route.origin, route.destination);
+    graphDirty = true;
     return true;
 }
 
@@ -201,10 +560,17 @@ Route* DataStore::getRoute(const std::string& routeId) {
     return (it != routes.end()) ? &it->second : nullptr;
 }
 
+Route* DataStore::getRoute(const std::string& origin, const std::string& destination) {
+    // Same as getRoute(origin + "-" + destination) without building the id
+    auto it = routes.findJoined(origin, '-', destination);
+    return (it != routes.end()) ? &it->second : nullptr;
+}
+
 std::vector<Route> DataStore::getAllRoutes() const {
     std::vector<Route> result;
-    for (const auto& pair : routes) {
-        result.push_back(pair.second);
+    result.reserve(routes.size());
+    for (const auto* record : routes.valuesByKey()) {
+        result.push_back(*record);
     }
     return result;
 }
@@ -216,8 +582,14 @@ bool DataStore::addFlight(const Flight& flight) {
         return false;
     }
 
-    flights[flight.flightNumber] = flight;
-    pushUndo(Action(ActionType::ADD_FLIGHT, flight.flightNumber));
+    auto stored = flights.try_emplace(flight.flightNumber, flight).first;
+    if (flightIndexValid) {
+        flightIndex.insert(stored.handle(), stored->second);
+        scheduler.add(stored.handle(), stored->second);
+    }
+    timetable.reset();
+    recordChange(Action(ActionType::ADD_FLIGHT, flight.flightNumber));
+    journalPut(flight);
     return true;
 }
 
@@ -227,8 +599,14 @@ bool DataStore::deleteFlight(const std::string& flightNum) {
         return false;
     }
 
-    pushUndo(Action(ActionType::DELETE_FLIGHT, flightNum));
+    recordChange(Action(ActionType::DELETE_FLIGHT, flightNum));
+    if (flightIndexValid) {
+        flightIndex.erase(it.handle(), it->second);
+        scheduler.remove(it.handle(), it->second);
+    }
+    timetable.reset();
     flights.erase(it);
+    journalDelete(DEL_FLIGHT, flightNum);
     return true;
 }
 
@@ -239,38 +617,238 @@ Flight* DataStore::getFlight(const std::string& flightNum) {
 
 std::vector<Flight> DataStore::getAllFlights() const {
     std::vector<Flight> result;
-    for (const auto& pair : flights) {
-        result.push_back(pair.second);
+    result.reserve(flights.size());
+    for (const auto* record : flights.valuesByKey()) {
+        result.push_back(*record);
+    }
+    return result;
+}
+
+// ==================== PAGED QUERIES ====================
+
+Page<Airport> DataStore::getAirportPage(size_t offset, size_t limit) const {
+    return collectPage(airports, offset, limit, [](const Airport&) { return true; });
+}
+
+Page<Aircraft> DataStore::getAircraftPage(size_t offset, size_t limit,
+                                          std::optional<AircraftStatus> status) const {
+    return collectPage(aircraft, offset, limit, [&](const Aircraft& ac) {
+        return !status || ac.status == *status;
+    });
+}
+
+Page<Route> DataStore::getRoutePage(size_t offset, size_t limit,
+                                    const std::string& airport) const {
+    return collectPage(routes, offset, limit, [&](const Route& route) {
+        return airport.empty() || route.origin == airport || route.destination == airport;
+    });
+}
+
+Page<Flight> DataStore::getFlightPage(size_t offset, size_t limit,
+                                      const FlightFilter& filter) const {
+    if (filter.airport.empty()) {
+        return collectPage(flights, offset, limit, [&](const Flight& flight) {
+            return filter.status.empty() || flight.status == filter.status;
+        });
+    }
+
+    // Only the airport's flights, from its index (in departure order)
+    Page<Flight> page;
+    page.offset = offset;
+    for (const Flight* flight : getFlightsByAirport(filter.airport)) {
+        if (!filter.status.empty() && flight->status != filter.status) continue;
+        if (page.total >= offset && page.items.size() < limit) {
+            page.items.push_back(*flight);
+        }
+        ++page.total;
+    }
+    return page;
+}
+
+// ==================== FLIGHT INDEXES ====================
+
+std::vector<const Flight*> DataStore::getFlightsByAircraft(const std::string& aircraftId,
+                                                          int64_t from, int64_t to) const {
+    ensureFlightIndex();
+    return resolveFlights(flightIndex.findByAircraft(aircraftId, from, to));
+}
+
+std::vector<const Flight*> DataStore::getFlightsByAirport(const std::string& code,
+                                                         int64_t from, int64_t to) const {
+    ensureFlightIndex();
+    return resolveFlights(flightIndex.findByAirport(code, from, to));
+}
+
+std::vector<const Flight*> DataStore::getFlightsDepartingBetween(int64_t from, int64_t to) const {
+    ensureFlightIndex();
+    return resolveFlights(flightIndex.findByDeparture(from, to));
+}
+
+std::vector<const Flight*> DataStore::findScheduleConflicts(const Flight& candidate) const {
+    int64_t start, end;
+    if (!Scheduling::getTimeWindow(candidate, start, end)) {
+        return {};
+    }
+
+    ensureFlightIndex();
+    std::vector<const Flight*> conflicts;
+    for (FlightScheduler::Handle handle : scheduler.findOverlaps(candidate.aircraftId, start, end)) {
+        const Flight& flight = flights.get(handle);
+        if (flight.flightNumber != candidate.flightNumber) {
+            conflicts.push_back(&flight);
+        }
+    }
+    return conflicts;
+}
+
+std::shared_ptr<const Timetable> DataStore::getTimetable() const {
+    if (!timetable) {
+        std::vector<const Flight*> all;
+        all.reserve(flights.size());
+        for (const Flight& flight : flights.values()) {
+            all.push_back(&flight);
+        }
+        timetable = std::make_shared<const Timetable>(Timetable::build(all, &airports));
+    }
+    return timetable;
+}
+
+void DataStore::ensureFlightIndex() const {
+    if (!flightIndexValid) {
+        flightIndex.rebuild(flights);
+        scheduler.rebuild(flights);
+        flightIndexValid = true;
+    }
+}
+
+std::vector<const Flight*> DataStore::resolveFlights(
+    const std::vector<FlightIndex::Handle>& handles) const {
+    std::vector<const Flight*> result;
+    result.reserve(handles.size());
+    for (FlightIndex::Handle handle : handles) {
+        result.push_back(&flights.get(handle));
     }
     return result;
 }
 
 // ==================== GRAPH MANAGEMENT ====================
 
-Graph& DataStore::getGraph() {
-    return graph;
+std::shared_ptr<const GraphSnapshot> DataStore::getGraphSnapshot() const {
+    // Fast path: nothing edited since the last publish
+    if (!graphDirty) {
+        return std::atomic_load(&graphSnapshot);
+    }
+
+    std::lock_guard<std::mutex> lock(graphMutex);
+    if (graphDirty) {
+        publishGraph();
+    }
+    return std::atomic_load(&graphSnapshot);
+}
+
+const Graph& DataStore::getGraph() const {
+    getGraphSnapshot();
+    return std::atomic_load(&graphSnapshot)->getGraph();
+}
+
+std::shared_ptr<const CompactGraph> DataStore::getCompactGraph() const {
+    return getGraphSnapshot()->getCompactGraph();
+}
+
+std::shared_ptr<const ContractionHierarchy> DataStore::getContractionHierarchy() const {
+    // Preprocessed once per snapshot on first use
+    return getGraphSnapshot()->getContractionHierarchy();
 }
 
 void DataStore::rebuildGraph() {
-    graph.clear();
+    std::lock_guard<std::mutex> lock(graphMutex);
+    rebuildWorkingGraph();
+    publishGraph();
+
+    std::cout << "✓ Graph rebuilt: " << workingGraph.getNodeCount()
+              << " nodes, " << workingGraph.getEdgeCount() << " edges" << std::endl;
+}
+
+void DataStore::ensureWorkingGraph() {
+    if (!workingGraphValid) {
+        rebuildWorkingGraph();
+    }
+}
+
+void DataStore::rebuildWorkingGraph() {
+    workingGraphValid = true;
+    workingGraph.clear();
+    nodeCoordinates.clear();
 
     // Register all airport nodes
     for (const auto& [code, airport] : airports) {
-        graph.addNode(code);
+        workingGraph.addNode(code);
+        nodeCoordinates[code] = {airport.latitude, airport.longitude};
     }
 
-    // Add all operational routes as bidirectional edges
+    // Add all operational routes as bidirectional edges. When "a-b" and
+    // "b-a" are both operational the greater id wins, whatever the table's
+    // iteration order (refreshRouteEdges() applies the same rule).
     for (const auto& [id, route] : routes) {
-        if (route.operational) {
-            graph.addEdge(route.origin, route.destination,
-                          route.distance, route.baseCost);
-            graph.addEdge(route.destination, route.origin,
-                          route.distance, route.baseCost);
+        if (!route.operational) {
+            continue;
         }
+        auto reverse = routes.findJoined(route.destination, '-', route.origin);
+        if (reverse != routes.end() && reverse->first != id && reverse->second.operational &&
+            id < reverse->first) {
+            continue;
+        }
+        workingGraph.addEdge(route.origin, route.destination, route.distance, route.baseCost);
+        workingGraph.addEdge(route.destination, route.origin, route.distance, route.baseCost);
+    }
+}
+
+void DataStore::refreshRouteEdges(const std::string& a, const std::string& b) {
+    // Both directions a<->b come from routes "a-b" and "b-a". Match
+    // rebuildGraph(): of two operational ones, the greater id wins.
+    auto operational = [this](const std::string& from, const std::string& to) -> const Route* {
+        auto it = routes.findJoined(from, '-', to);
+        return (it != routes.end() && it->second.operational) ? &it->second : nullptr;
+    };
+    const Route* winner = operational(a, b);
+    const Route* backward = operational(b, a);
+    if (backward && (!winner || a < b)) {
+        winner = backward;   // "b-a" > "a-b" exactly when a < b
+    }
+
+    if (winner) {
+        workingGraph.addEdge(a, b, winner->distance, winner->baseCost);
+        workingGraph.addEdge(b, a, winner->distance, winner->baseCost);
+        return;
     }
 
-    std::cout << "✓ Graph rebuilt: " << graph.getNodeCount()
-              << " nodes, " << graph.getEdgeCount() << " edges" << std::endl;
+    workingGraph.removeEdge(a, b);
+    workingGraph.removeEdge(b, a);
+
+    // Endpoints that are not airports only exist through their routes
+    for (const std::string& code : {a, b}) {
+        if (airports.find(code) == airports.end() &&
+            workingGraph.neighbors(code).empty() && workingGraph.getInDegree(code) == 0) {
+            workingGraph.removeNode(code);
+        }
+    }
+}
+
+void DataStore::publishGraph(std::shared_ptr<CompactGraph> compact) const {
+    // Build the next version off to the side; readers keep the current one.
+    // CSR (unless prebuilt), with coordinates for the A* heuristic
+    if (!compact) {
+        compact = std::make_shared<CompactGraph>(workingGraph);
+    }
+    for (const auto& [code, position] : nodeCoordinates) {
+        compact->setCoordinates(code, position.first, position.second);
+    }
+
+    auto next = std::make_shared<const GraphSnapshot>(++graphVersion, compact);
+
+    // Publish; the old version lives on until its last reader lets go
+    std::atomic_store(&graphSnapshot, next);
+    graphDirty = false;
 }
 
 // ==================== UNDO SYSTEM ====================
@@ -313,255 +891,389 @@ void DataStore::pushUndo(const Action& action) {
 
 // ==================== CSV LOADING ====================
 
-bool DataStore::loadAirports() {
-    std::ifstream file(AIRPORTS_FILE);
-    if (!file.is_open()) {
-        std::cout << "⚠ airports.txt not found, creating empty file" << std::endl;
+bool DataStore::loadAirports(LoadLog& log) {
+    CsvReader csv;
+    if (!csv.open(AIRPORTS_FILE)) {
+        log.info << "⚠ airports.txt not found, creating empty file\n";
         return true;
     }
 
-    std::string line;
-    std::getline(file, line); // Skip header
+    csv.next(); // Skip header
 
     int count = 0;
-    while (std::getline(file, line)) {
-        if (line.empty()) continue;
-
-        auto parts = split(line, ',');
-        if (parts.size() >= 6) {
-            try {
-                Airport airport;
-                airport.code = trim(parts[0]);
-                airport.name = trim(parts[1]);
-                airport.city = trim(parts[2]);
-                airport.country = trim(parts[3]);
-                airport.latitude = std::stod(trim(parts[4]));
-                airport.longitude = std::stod(trim(parts[5]));
-                airports[airport.code] = airport;
-                count++;
-            } catch (...) {
-                std::cerr << "Error parsing airport line: " << line << std::endl;
-            }
+    while (csv.next()) {
+        if (csv.getFieldCount() < 6) continue;
+
+        Airport airport;
+        if (!parseAirportRow(csv, 0, airport)) {
+            log.errors << "Error parsing airport line " << csv.getLineNumber()
+                       << ": " << csv.getLine() << "\n";
+            continue;
         }
+        airports[airport.code] = std::move(airport);
+        count++;
     }
 
-    file.close();
-    std::cout << "✓ Loaded " << count << " airports" << std::endl;
+    log.info << "✓ Loaded " << count << " airports\n";
     return true;
 }
 
-bool DataStore::loadAircraft() {
-    std::ifstream file(AIRCRAFT_FILE);
-    if (!file.is_open()) {
-        std::cout << "⚠ aircraft.txt not found, creating empty file" << std::endl;
+bool DataStore::loadAircraft(LoadLog& log) {
+    CsvReader csv;
+    if (!csv.open(AIRCRAFT_FILE)) {
+        log.info << "⚠ aircraft.txt not found, creating empty file\n";
         return true;
     }
 
-    std::string line;
-    std::getline(file, line); // Skip header
+    csv.next(); // Skip header
 
     int count = 0;
-    while (std::getline(file, line)) {
-        if (line.empty()) continue;
-
-        auto parts = split(line, ',');
-        if (parts.size() >= 6) {
-            try {
-                Aircraft ac;
-                ac.id = trim(parts[0]);
-                ac.model = trim(parts[1]);
-                ac.capacity = std::stoi(trim(parts[2]));
-                ac.cruiseSpeed = std::stod(trim(parts[3]));
-                ac.fuelConsumption = std::stod(trim(parts[4]));
-                ac.status = Aircraft::stringToStatus(trim(parts[5]));
-                aircraft[ac.id] = ac;
-                count++;
-            } catch (...) {
-                std::cerr << "Error parsing aircraft line: " << line << std::endl;
-            }
+    while (csv.next()) {
+        if (csv.getFieldCount() < 6) continue;
+
+        Aircraft ac;
+        if (!parseAircraftRow(csv, 0, ac)) {
+            log.errors << "Error parsing aircraft line " << csv.getLineNumber()
+                       << ": " << csv.getLine() << "\n";
+            continue;
         }
+        aircraft[ac.id] = std::move(ac);
+        count++;
     }
 
-    file.close();
-    std::cout << "✓ Loaded " << count << " aircraft" << std::endl;
+    log.info << "✓ Loaded " << count << " aircraft\n";
     return true;
 }
 
-bool DataStore::loadRoutes() {
-    std::ifstream file(ROUTES_FILE);
-    if (!file.is_open()) {
-        std::cout << "⚠ routes.txt not found, creating empty file" << std::endl;
+bool DataStore::loadRoutes(LoadLog& log) {
+    CsvReader csv;
+    if (!csv.open(ROUTES_FILE)) {
+        log.info << "⚠ routes.txt not found, creating empty file\n";
         return true;
     }
 
-    std::string line;
-    std::getline(file, line); // Skip header
+    csv.next(); // Skip header
 
     int count = 0;
-    while (std::getline(file, line)) {
-        if (line.empty()) continue;
-
-        auto parts = split(line, ',');
-        if (parts.size() >= 5) {
-            try {
-                Route route;
-                route.origin = trim(parts[0]);
-                route.destination = trim(parts[1]);
-                route.distance = std::stod(trim(parts[2]));
-                route.baseCost = std::stod(trim(parts[3]));
-                route.operational = (trim(parts[4]) == "1" || trim(parts[4]) == "true");
-                routes[route.getId()] = route;
-                count++;
-            } catch (...) {
-                std::cerr << "Error parsing route line: " << line << std::endl;
-            }
+    while (csv.next()) {
+        if (csv.getFieldCount() < 5) continue;
+
+        Route route;
+        if (!parseRouteRow(csv, 0, route)) {
+            log.errors << "Error parsing route line " << csv.getLineNumber()
+                       << ": " << csv.getLine() << "\n";
+            continue;
         }
+        routes[route.getId()] = std::move(route);
+        count++;
     }
 
-    file.close();
-    std::cout << "✓ Loaded " << count << " routes" << std::endl;
+    log.info << "✓ Loaded " << count << " routes\n";
     return true;
 }
 
-bool DataStore::loadFlights() {
-    std::ifstream file(FLIGHTS_FILE);
-    if (!file.is_open()) {
-        std::cout << "⚠ flights.txt not found, creating empty file" << std::endl;
+bool DataStore::loadFlights(LoadLog& log) {
+    CsvReader csv;
+    if (!csv.open(FLIGHTS_FILE)) {
+        log.info << "⚠ flights.txt not found, creating empty file\n";
         return true;
     }
 
-    std::string line;
-    std::getline(file, line); // Skip header
+    // Split the buffer into chunks at line boundaries; small files stay
+    // in one chunk
+    const std::string_view text = csv.getText();
+    const size_t MIN_CHUNK_BYTES = 1 << 20;
+    size_t chunkCount = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()),
+                                         text.size() / MIN_CHUNK_BYTES + 1);
+
+    std::vector<size_t> bounds = CsvReader::chunkBounds(text, chunkCount);
+    chunkCount = bounds.size() - 1;
+
+    struct Chunk {
+        std::vector<Flight> flights;
+        std::vector<std::pair<int, std::string>> errors;   // Chunk-local line, text
+        int lineCount = 0;
+    };
+    std::vector<Chunk> chunks(chunkCount);
+
+    auto parseChunk = [&](size_t k) {
+        std::string_view piece = text.substr(bounds[k], bounds[k + 1] - bounds[k]);
+        Chunk& chunk = chunks[k];
+        chunk.lineCount = static_cast<int>(std::count(piece.begin(), piece.end(), '\n'));
+
+        CsvReader rows(piece);
+        if (k == 0) rows.next(); // Skip header
+
+        while (rows.next()) {
+            if (rows.getFieldCount() < 8) continue;
+
+            Flight flight;
+            if (!parseFlightRow(rows, 0, flight)) {
+                chunk.errors.emplace_back(rows.getLineNumber(), std::string(rows.getLine()));
+                continue;
+            }
+            chunk.flights.push_back(std::move(flight));
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t k = 1; k < chunkCount; ++k) {
+        workers.emplace_back(parseChunk, k);
+    }
+    parseChunk(0);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    // Merge in file order, so duplicates resolve exactly as a sequential
+    // load would (last one wins)
+    size_t parsed = 0;
+    for (const Chunk& chunk : chunks) {
+        parsed += chunk.flights.size();
+    }
+    flights.reserve(flights.size() + parsed);
 
     int count = 0;
-    while (std::getline(file, line)) {
-        if (line.empty()) continue;
-
-        auto parts = split(line, ',');
-        if (parts.size() >= 8) {
-            try {
-                Flight flight;
-                flight.flightNumber = trim(parts[0]);
-                flight.aircraftId = trim(parts[1]);
-
-                // Parse route (format: JFK-LHR-DXB)
-                std::string routeStr = trim(parts[2]);
-                std::stringstream ss(routeStr);
-                std::string airport;
-                while (std::getline(ss, airport, '-')) {
-                    flight.route.push_back(trim(airport));
-                }
-
-                flight.totalDistance = std::stod(trim(parts[3]));
-                flight.totalCost = std::stod(trim(parts[4]));
-                flight.estimatedTime = std::stod(trim(parts[5]));
-                flight.departureTime = trim(parts[6]);
-                flight.status = trim(parts[7]);
-
-                flights[flight.flightNumber] = flight;
-                count++;
-            } catch (...) {
-                std::cerr << "Error parsing flight line: " << line << std::endl;
-            }
+    int linesBefore = 0;
+    for (Chunk& chunk : chunks) {
+        for (const auto& [line, content] : chunk.errors) {
+            log.errors << "Error parsing flight line " << linesBefore + line
+                       << ": " << content << "\n";
+        }
+        for (Flight& flight : chunk.flights) {
+            const std::string key = flight.flightNumber;
+            flights.insert_or_assign(key, std::move(flight));
+            count++;
         }
+        linesBefore += chunk.lineCount;
     }
 
-    file.close();
-    std::cout << "✓ Loaded " << count << " flights" << std::endl;
+    log.info << "✓ Loaded " << count << " flights\n";
     return true;
 }
 
-// ==================== CSV SAVING ====================
+// ==================== JOURNAL ====================
+
+void DataStore::journalPut(const Airport& airport) {
+    if (!journal.isOpen()) return;
+    std::ostringstream record;
+    record << PUT_AIRPORT << ",";
+    writeAirportRow(record, airport);
+    journal.append(record.str());
+}
+
+void DataStore::journalPut(const Aircraft& ac) {
+    if (!journal.isOpen()) return;
+    std::ostringstream record;
+    record << PUT_AIRCRAFT << ",";
+    writeAircraftRow(record, ac);
+    journal.append(record.str());
+}
+
+void DataStore::journalPut(const Route& route) {
+    if (!journal.isOpen()) return;
+    std::ostringstream record;
+    record << PUT_ROUTE << ",";
+    writeRouteRow(record, route);
+    journal.append(record.str());
+}
+
+void DataStore::journalPut(const Flight& flight) {
+    if (!journal.isOpen()) return;
+    std::ostringstream record;
+    record << PUT_FLIGHT << ",";
+    writeFlightRow(record, flight);
+    journal.append(record.str());
+}
+
+void DataStore::journalDelete(const char* tag, const std::string& key) {
+    if (!journal.isOpen()) return;
+    journal.append(std::string(tag) + "," + key);
+}
+
+uint64_t DataStore::replayJournal() {
+    uint64_t skipped = 0;
+    uint64_t replayed = Journal::replay(JOURNAL_FILE, [&](std::string_view record) {
+        if (!applyJournalRecord(record)) {
+            std::cerr << "⚠ Skipping journal record: " << record << std::endl;
+            ++skipped;
+        }
+    });
+
+    if (replayed > 0) {
+        std::cout << "✓ Replayed " << replayed - skipped << " journal records" << std::endl;
+    }
+    return replayed;
+}
 
-bool DataStore::saveAirports() {
-    std::ofstream file(AIRPORTS_FILE);
-    if (!file.is_open()) {
+bool DataStore::applyJournalRecord(std::string_view record) {
+    // Maps only: the caller rebuilds the graph once after the replay
+    CsvReader csv(record);
+    if (!csv.next() || csv.getFieldCount() < 2) {
         return false;
     }
 
-    file << "Code,Name,City,Country,Latitude,Longitude\n";
+    const std::string_view tag = csv.field(0);
+    const std::string key = csv.fieldString(1);
+
+    if (tag == PUT_AIRPORT) {
+        Airport airport;
+        if (!parseAirportRow(csv, 1, airport)) return false;
+        airports[airport.code] = std::move(airport);
+    } else if (tag == DEL_AIRPORT) {
+        airports.erase(key);
+        for (auto it = routes.begin(); it != routes.end();) {
+            bool touches = it->second.origin == key || it->second.destination == key;
+            it = touches ? routes.erase(it) : std::next(it);
+        }
+    } else if (tag == PUT_AIRCRAFT) {
+        Aircraft ac;
+        if (!parseAircraftRow(csv, 1, ac)) return false;
+        aircraft[ac.id] = std::move(ac);
+    } else if (tag == DEL_AIRCRAFT) {
+        aircraft.erase(key);
+    } else if (tag == PUT_ROUTE) {
+        Route route;
+        if (!parseRouteRow(csv, 1, route)) return false;
+        routes[route.getId()] = std::move(route);
+    } else if (tag == DEL_ROUTE) {
+        routes.erase(key);
+    } else if (tag == PUT_FLIGHT) {
+        Flight flight;
+        if (!parseFlightRow(csv, 1, flight)) return false;
+        flights[flight.flightNumber] = std::move(flight);
+    } else if (tag == DEL_FLIGHT) {
+        flights.erase(key);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// ==================== BINARY IMAGE ====================
+
+bool DataStore::isBinaryCurrent() const {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+
+    auto imageTime = fs::last_write_time(BINARY_FILE, ec);
+    if (ec) return false;
+
+    // A CSV edited after the image was written wins
+    for (const std::string& csv : {AIRPORTS_FILE, AIRCRAFT_FILE, ROUTES_FILE, FLIGHTS_FILE}) {
+        auto csvTime = fs::last_write_time(csv, ec);
+        if (!ec && csvTime > imageTime) return false;
+    }
+    return true;
+}
+
+bool DataStore::loadBinary() {
+    BinaryStore::Contents contents;
+    std::string error;
+    if (!BinaryStore::load(BINARY_FILE, contents, error)) {
+        std::cerr << "⚠ Ignoring binary image (" << error << "), loading CSV" << std::endl;
+        return false;
+    }
+
+    airports.swap(contents.airports);
+    aircraft.swap(contents.aircraft);
+    routes.swap(contents.routes);
+    flights.swap(contents.flights);
+
+    // Adopt the stored CSR instead of building one; the working graph is
+    // only materialized if the network is edited
+    std::lock_guard<std::mutex> lock(graphMutex);
+    workingGraph.clear();
+    workingGraphValid = false;
+    nodeCoordinates.clear();
     for (const auto& [code, airport] : airports) {
-        file << airport.code << ","
-             << airport.name << ","
-             << airport.city << ","
-             << airport.country << ","
-             << airport.latitude << ","
-             << airport.longitude << "\n";
+        nodeCoordinates[code] = {airport.latitude, airport.longitude};
     }
+    publishGraph(contents.graph);
 
-    file.close();
+    std::cout << "✓ Loaded " << airports.size() << " airports, " << aircraft.size()
+              << " aircraft, " << routes.size() << " routes, " << flights.size()
+              << " flights from binary image" << std::endl;
     return true;
 }
 
-bool DataStore::saveAircraft() {
-    std::ofstream file(AIRCRAFT_FILE);
-    if (!file.is_open()) {
+bool DataStore::saveBinary(const EntityTable<Airport>& airportData,
+                           const EntityTable<Aircraft>& aircraftData,
+                           const EntityTable<Route>& routeData,
+                           const EntityTable<Flight>& flightData,
+                           const CompactGraph& graph) const {
+    if (!BinaryStore::save(BINARY_FILE, airportData, aircraftData, routeData, flightData, graph)) {
+        std::cerr << "⚠ Could not write binary image " << BINARY_FILE << std::endl;
         return false;
     }
+    return true;
+}
+
+// ==================== CSV SAVING ====================
+
+bool DataStore::saveAirports(const EntityTable<Airport>& airportData) const {
+    AtomicFileWriter writer(AIRPORTS_FILE);
+    if (!writer.isOpen()) {
+        return false;
+    }
+    std::ostream& file = writer.stream();
+
+    file << "Code,Name,City,Country,Latitude,Longitude\n";
+    for (const auto* airport : airportData.valuesByKey()) {
+        writeAirportRow(file, *airport);
+        file << "\n";
+    }
+
+    return writer.commit();
+}
+
+bool DataStore::saveAircraft(const EntityTable<Aircraft>& aircraftData) const {
+    AtomicFileWriter writer(AIRCRAFT_FILE);
+    if (!writer.isOpen()) {
+        return false;
+    }
+    std::ostream& file = writer.stream();
 
     file << "ID,Model,Capacity,CruiseSpeed,FuelConsumption,Status\n";
-    for (const auto& [id, ac] : aircraft) {
-        file << ac.id << ","
-             << ac.model << ","
-             << ac.capacity << ","
-             << ac.cruiseSpeed << ","
-             << ac.fuelConsumption << ","
-             << Aircraft::statusToString(ac.status) << "\n";
+    for (const auto* ac : aircraftData.valuesByKey()) {
+        writeAircraftRow(file, *ac);
+        file << "\n";
     }
 
-    file.close();
-    return true;
+    return writer.commit();
 }
 
-bool DataStore::saveRoutes() {
-    std::ofstream file(ROUTES_FILE);
-    if (!file.is_open()) {
+bool DataStore::saveRoutes(const EntityTable<Route>& routeData) const {
+    AtomicFileWriter writer(ROUTES_FILE);
+    if (!writer.isOpen()) {
         return false;
     }
+    std::ostream& file = writer.stream();
 
     file << "Origin,Destination,Distance,BaseCost,Operational\n";
-    for (const auto& [id, route] : routes) {
-        file << route.origin << ","
-             << route.destination << ","
-             << route.distance << ","
-             << route.baseCost << ","
-             << (route.operational ? "1" : "0") << "\n";
+    for (const auto* route : routeData.valuesByKey()) {
+        writeRouteRow(file, *route);
+        file << "\n";
     }
 
-    file.close();
-    return true;
+    return writer.commit();
 }
 
-bool DataStore::saveFlights() {
-    std::ofstream file(FLIGHTS_FILE);
-    if (!file.is_open()) {
+bool DataStore::saveFlights(const EntityTable<Flight>& flightData) const {
+    AtomicFileWriter writer(FLIGHTS_FILE);
+    if (!writer.isOpen()) {
         return false;
     }
+    std::ostream& file = writer.stream();
 
     file << "FlightNumber,AircraftID,Route,TotalDistance,TotalCost,EstimatedTime,DepartureTime,Status\n";
 
-    for (const auto& [flightNum, flight] : flights) {
-        file << flight.flightNumber << ",";
-        file << flight.aircraftId << ",";
-
-        // Write route as: JFK-LHR-DXB
-        for (size_t i = 0; i < flight.route.size(); ++i) {
-            file << flight.route[i];
-            if (i < flight.route.size() - 1) {
-                file << "-";
-            }
-        }
-        file << ",";
-
-        file << flight.totalDistance << ",";
-        file << flight.totalCost << ",";
-        file << flight.estimatedTime << ",";
-        file << flight.departureTime << ",";
-        file << flight.status << "\n";
+    for (const auto* flight : flightData.valuesByKey()) {
+        writeFlightRow(file, *flight);
+        file << "\n";
     }
 
-    file.close();
-    return true;
+    return writer.commit();
 }
 
 // ==================== UTILITY FUNCTIONS ====================
@@ -578,14 +1290,6 @@ std::vector<std::string> DataStore::split(const std::string& str, char delimiter
     return tokens;
 }
 
-std::string DataStore::trim(const std::string& str) {
-    size_t first = str.find_first_not_of(" \t\r\n");
-    if (first == std::string::npos) return "";
-
-    size_t last = str.find_last_not_of(" \t\r\n");
-    return str.substr(first, last - first + 1);
-}
-
 std::string DataStore::serializeAirport(const Airport& a) {
     return a.code + "," + a.name + "," + a.city + "," + a.country;
 }
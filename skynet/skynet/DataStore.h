@@ -6,11 +6,24 @@
 #include "Route.h"
 #include "Flight.h"
 #include "Graph.h"
-#include <map>
+#include "EntityTable.h"
+#include "FlightIndex.h"
+#include "FlightScheduler.h"
+#include "Timetable.h"
+#include "TimeUtil.h"
+#include "GraphSnapshot.h"
+#include "Journal.h"
+#include "PersistenceService.h"
 #include <vector>
 #include <stack>
 #include <string>
+#include <string_view>
 #include <memory>
+#include <atomic>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+#include <optional>
 
 /**
  * @brief Undo action types for the undo stack
@@ -25,7 +38,8 @@ enum class ActionType {
     ADD_ROUTE,
     DELETE_ROUTE,
     ADD_FLIGHT,
-    DELETE_FLIGHT
+    DELETE_FLIGHT,
+    BULK_CHANGE     // data = number of changes committed together
 };
 
 /**
@@ -39,6 +53,25 @@ struct Action {
     Action(ActionType t, const std::string& d) : type(t), data(d) {}
 };
 
+/**
+ * @brief One page of a query result
+ * Only the page's records are copied; total counts every match
+ */
+template <typename T>
+struct Page {
+    std::vector<T> items;
+    size_t offset = 0;   // Index of items[0] among all matches
+    size_t total = 0;    // Matches across all pages
+};
+
+/**
+ * @brief Flight query filter; empty fields match anything
+ */
+struct FlightFilter {
+    std::string status;    // e.g. "SCHEDULED"
+    std::string airport;   // Origin, stop or destination
+};
+
 /**
  * @brief Singleton DataStore managing all application data
  *
@@ -47,16 +80,74 @@ struct Action {
  * - Global access point without global variables
  * - Ensures only one instance manages file I/O and graph
  *
- * Why std::map for storage?
- * - O(log n) lookup by ID/code
- * - Automatic sorting by key
- * - No duplicates
+ * Why EntityTable for storage?
+ * - Hashed O(1) lookup by ID/code, no duplicates
+ * - Records sit in pooled chunks under stable handles; pointers from
+ *   getAirport() and friends stay valid until the record is deleted
+ * - Table iteration and view*() follow slot order, which deletions
+ *   shuffle (a new record may take a freed, earlier slot). getAll*(),
+ *   get*Page(), the manager lists and the saved files sort by key, so
+ *   what users see keeps std::map's order
+ *
+ * Why views and pages?
+ * - getAll*() copies every record, which the map repainted and the
+ *   managers refreshed over and over
+ * - view*() returns a range over the stored records and get*Count() the
+ *   size, neither copying anything
+ * - get*Page() copies just one page (offset/limit), optionally filtered,
+ *   so large tables are shown a page at a time
+ *
+ * Why flight indexes?
+ * - FlightIndex orders flights by departure time per aircraft, per
+ *   airport and overall, so getFlightsByAircraft/ByAirport/
+ *   DepartingBetween() and airport-filtered pages cost O(log n + k)
+ * - FlightScheduler holds each aircraft's scheduled time windows, so
+ *   findScheduleConflicts() checks a booking in O(log n + k)
+ * - Both are built on first use (loading does not pay for them), then
+ *   kept up to date by addFlight() and deleteFlight()
+ * - getTimetable() turns the scheduled flights into the connection
+ *   array ConnectionScan routes over. It is also built on first use and
+ *   dropped by any flight or airport change (multi-stop leg times follow
+ *   airport coordinates); holders keep the version they have
  *
  * Responsibilities:
  * - CRUD operations for all entities
- * - CSV file I/O (manual parsing, no libraries)
- * - Graph lifecycle management (rebuild on data change)
+ * - CSV file I/O (manual parsing, no libraries), with a binary image
+ *   (BinaryStore) that loadAll() prefers while it is newer than the CSVs
+ * - Every file is rewritten through AtomicFileWriter (temp file, fsync,
+ *   rename), so a crash mid-save never leaves a truncated data file
+ * - The four CSVs load concurrently; the flights file, by far the
+ *   largest, is additionally split into chunks parsed in parallel
+ * - Graph lifecycle management (edits applied as deltas to a working
+ *   graph; a new snapshot is published on the next read after a change)
  * - Undo stack (last 5 destructive operations)
+ *
+ * Why a journal?
+ * - Every CRUD call appends one record to data_files/journal.log, so
+ *   making an edit durable (syncJournal()) costs a small append and an
+ *   fsync shared with concurrent edits, whatever the size of the data
+ * - saveAll() is the compaction step: it rewrites the CSVs and binary
+ *   image, then drops the journal records they now contain. loadAll()
+ *   replays the journal over the base files; records are idempotent
+ *   (put or delete by key), so a crash between rewriting the CSVs and
+ *   compacting the log is harmless
+ *
+ * Why save in the background?
+ * - saveAllAsync() copies the four containers (plus the immutable graph
+ *   snapshot and the journal position) and hands them to a
+ *   PersistenceService thread, which formats, writes and compacts while
+ *   the GUI keeps running; edits made meanwhile stay in the journal
+ * - syncJournal() starts such a compaction once the journal grows long
+ *
+ * Why bulk transactions?
+ * - Each CRUD call normally records undo and updates the graph, and a
+ *   saveAll() call rewrites all four CSVs
+ * - Between beginBulk() and commitBulk() those are deferred: the graph
+ *   is rebuilt once, one undo entry covers the batch and at most one
+ *   save is started (in the background), so a large import costs about
+ *   the same as loadAll()
+ * - Transactions nest; only the outermost commit applies the work
+ * - Readers keep seeing the last published graph until the commit
  */
 class DataStore {
 public:
@@ -67,8 +158,27 @@ public:
     DataStore& operator=(const DataStore&) = delete;
 
     // Initialization
+    using SaveCallback = PersistenceService::Callback;
+
     bool loadAll();
-    bool saveAll();
+    bool saveAll();   // Blocks until written; deferred to commit inside a bulk transaction
+
+    // Snapshot now, write on the persistence thread; done runs there too
+    void saveAllAsync(SaveCallback done = SaveCallback());
+    bool isSaving() const { return persistence.isBusy(); }
+
+    // Make every edit so far durable through the journal (falls back to
+    // saveAll() when no journal is open)
+    bool syncJournal();
+
+    // Wait for background saves, then fold the journal into the base
+    // files if it has any records
+    bool compactJournal();
+
+    // Bulk transactions (see BulkTransaction for the scoped form)
+    void beginBulk();
+    void commitBulk();
+    bool inBulk() const { return bulkDepth > 0; }
 
     // Airport CRUD
     bool addAirport(const Airport& airport);
@@ -89,6 +199,7 @@ public:
     bool deleteRoute(const std::string& routeId);
     bool updateRoute(const Route& route);
     Route* getRoute(const std::string& routeId);
+    Route* getRoute(const std::string& origin, const std::string& destination);
     std::vector<Route> getAllRoutes() const;
 
     // Flight CRUD
@@ -97,8 +208,61 @@ public:
     Flight* getFlight(const std::string& flightNum);
     std::vector<Flight> getAllFlights() const;
 
+    // Read without copying. Ranges and references are valid until the
+    // next edit; use them on the thread that edits (the GUI thread)
+    EntityTable<Airport>::const_value_range viewAirports() const { return airports.values(); }
+    EntityTable<Aircraft>::const_value_range viewAircraft() const { return aircraft.values(); }
+    EntityTable<Route>::const_value_range viewRoutes() const { return routes.values(); }
+    EntityTable<Flight>::const_value_range viewFlights() const { return flights.values(); }
+    size_t getAirportCount() const { return airports.size(); }
+    size_t getAircraftCount() const { return aircraft.size(); }
+    size_t getRouteCount() const { return routes.size(); }
+    size_t getFlightCount() const { return flights.size(); }
+
+    // Paged queries in table order; limit 0 only counts the matches
+    Page<Airport> getAirportPage(size_t offset, size_t limit) const;
+    Page<Aircraft> getAircraftPage(size_t offset, size_t limit,
+                                   std::optional<AircraftStatus> status = std::nullopt) const;
+    Page<Route> getRoutePage(size_t offset, size_t limit,
+                             const std::string& airport = std::string()) const;   // Either end
+    Page<Flight> getFlightPage(size_t offset, size_t limit,
+                               const FlightFilter& filter = FlightFilter()) const;
+
+    // Indexed flight queries: departures in [from, to) (epoch minutes,
+    // see TimeUtil), ordered by departure time. Pointers are valid until
+    // the flight is deleted
+    std::vector<const Flight*> getFlightsByAircraft(const std::string& aircraftId,
+                                                    int64_t from = TimeUtil::NO_TIME,
+                                                    int64_t to = TimeUtil::MAX_TIME) const;
+    std::vector<const Flight*> getFlightsByAirport(const std::string& code,
+                                                   int64_t from = TimeUtil::NO_TIME,
+                                                   int64_t to = TimeUtil::MAX_TIME) const;
+    std::vector<const Flight*> getFlightsDepartingBetween(int64_t from, int64_t to) const;
+
+    // Scheduled flights whose windows (Scheduling::getTimeWindow) overlap
+    // the candidate's on its aircraft, ordered by departure. Empty if it
+    // fits (or has no valid departure time). The candidate's own record,
+    // if stored, is not reported
+    std::vector<const Flight*> findScheduleConflicts(const Flight& candidate) const;
+
+    // Scheduled flights as connections for ConnectionScan
+    std::shared_ptr<const Timetable> getTimetable() const;
+
+    // Read-only tables. A record's handle (findHandle(), iterator::handle())
+    // names that record only: once it is deleted the handle is dead
+    // (isLive() false, get() throws) even if its slot is reused
+    const EntityTable<Airport>& getAirportTable() const { return airports; }
+    const EntityTable<Aircraft>& getAircraftTable() const { return aircraft; }
+    const EntityTable<Route>& getRouteTable() const { return routes; }
+    const EntityTable<Flight>& getFlightTable() const { return flights; }
+
     // Graph access
-    Graph& getGraph();
+    // Background work should hold a snapshot; the Graph reference from
+    // getGraph() is only valid until the next rebuild
+    std::shared_ptr<const GraphSnapshot> getGraphSnapshot() const;
+    const Graph& getGraph() const;
+    std::shared_ptr<const CompactGraph> getCompactGraph() const;
+    std::shared_ptr<const ContractionHierarchy> getContractionHierarchy() const;
     void rebuildGraph();
 
     // Undo system
@@ -110,13 +274,35 @@ private:
     DataStore();
 
     // Data containers
-    std::map<std::string, Airport> airports;
-    std::map<std::string, Aircraft> aircraft;
-    std::map<std::string, Route> routes;
-    std::map<std::string, Flight> flights;
+    EntityTable<Airport> airports;
+    EntityTable<Aircraft> aircraft;
+    EntityTable<Route> routes;
+    EntityTable<Flight> flights;
+
+    // Secondary flight indexes and live schedule, built lazily by
+    // ensureFlightIndex()
+    mutable FlightIndex flightIndex;
+    mutable FlightScheduler scheduler;
+    mutable bool flightIndexValid;
+
+    // Built by getTimetable(), reset when flights change
+    mutable std::shared_ptr<const Timetable> timetable;
 
-    // Graph for pathfinding
-    Graph graph;
+    // Working network, patched in place by CRUD calls. Edits only mark it
+    // dirty; the snapshot is rebuilt once on the next read, so a burst of
+    // edits costs one publish instead of one full rebuild per edit.
+    // graphMutex guards workingGraph, nodeCoordinates and publishing.
+    Graph workingGraph;
+    bool workingGraphValid;   // False after a binary load until first edit
+    std::unordered_map<std::string, std::pair<double, double>> nodeCoordinates;
+    mutable std::mutex graphMutex;
+    mutable std::atomic<bool> graphDirty;
+
+    // Last published network; only ever accessed through
+    // std::atomic_load/atomic_store so readers on other threads see either
+    // the old or the new version, never a partial one
+    mutable std::shared_ptr<const GraphSnapshot> graphSnapshot;
+    mutable uint64_t graphVersion;
 
     // Undo stack (max 5 items)
     std::stack<Action> undoStack;
@@ -127,24 +313,133 @@ private:
     const std::string AIRCRAFT_FILE = "data_files/aircraft.txt";
     const std::string ROUTES_FILE = "data_files/routes.txt";
     const std::string FLIGHTS_FILE = "data_files/flights.txt";
+    const std::string BINARY_FILE = "data_files/network.bin";
+    const std::string JOURNAL_FILE = "data_files/journal.log";
+
+    // Write-ahead log of edits since the last saveAll()
+    Journal journal;
+
+    // Bulk transaction state
+    int bulkDepth;
+    int bulkChangeCount;
+    bool bulkGraphStale;
+    bool bulkSavePending;
+    std::vector<SaveCallback> bulkSaveCallbacks;
+
+    // Journal length at which syncJournal() starts a background compaction
+    static const uint64_t COMPACT_AFTER_RECORDS = 10000;
+
+    // Private copy of the containers for a background save
+    struct SaveSnapshot {
+        EntityTable<Airport> airports;
+        EntityTable<Aircraft> aircraft;
+        EntityTable<Route> routes;
+        EntityTable<Flight> flights;
+        std::shared_ptr<const CompactGraph> graph;
+        uint64_t journalMark = 0;
+    };
+
+    // Last member: destroyed first, so pending saves finish while the
+    // journal they compact still exists
+    PersistenceService persistence;
+
+    // Record an undo entry, or count it toward the open transaction
+    void recordChange(const Action& action);
+
+    // True if the graph update is deferred to the transaction commit
+    bool deferGraphEdit();
+
+    void ensureFlightIndex() const;
+    std::vector<const Flight*> resolveFlights(const std::vector<FlightIndex::Handle>& handles) const;
+
+    // Graph maintenance (graphMutex must be held)
+    void rebuildWorkingGraph();
+    void ensureWorkingGraph();
+    void refreshRouteEdges(const std::string& a, const std::string& b);
+    void publishGraph(std::shared_ptr<CompactGraph> compact = nullptr) const;
+
+    // Journal records: "<TAG>,<CSV row>" for puts, "<TAG>,<key>" for deletes
+    void journalPut(const Airport& airport);
+    void journalPut(const Aircraft& ac);
+    void journalPut(const Route& route);
+    void journalPut(const Flight& flight);
+    void journalDelete(const char* tag, const std::string& key);
+    uint64_t replayJournal();
+    bool applyJournalRecord(std::string_view record);
+
+    // Binary image (BinaryStore): startup cache of the CSVs
+    bool isBinaryCurrent() const;
+    bool loadBinary();
+    bool saveBinary(const EntityTable<Airport>& airportData,
+                    const EntityTable<Aircraft>& aircraftData,
+                    const EntityTable<Route>& routeData,
+                    const EntityTable<Flight>& flightData,
+                    const CompactGraph& graph) const;
+
+    // Messages from one loader; loaders run concurrently, so output is
+    // collected and printed in a fixed order once all have finished
+    struct LoadLog {
+        std::ostringstream info;
+        std::ostringstream errors;
+    };
 
-    // CSV I/O helpers
-    bool loadAirports();
-    bool loadAircraft();
-    bool loadRoutes();
-    bool loadFlights();
-    bool saveAirports();
-    bool saveAircraft();
-    bool saveRoutes();
-    bool saveFlights();
+    // CSV I/O helpers (each loader only touches its own map)
+    bool loadAirports(LoadLog& log);
+    bool loadAircraft(LoadLog& log);
+    bool loadRoutes(LoadLog& log);
+    bool loadFlights(LoadLog& log);
+
+    // Writers run on the persistence thread: they only touch their
+    // arguments, the file paths and the (thread-safe) journal
+    bool writeBaseFiles(const EntityTable<Airport>& airportData,
+                        const EntityTable<Aircraft>& aircraftData,
+                        const EntityTable<Route>& routeData,
+                        const EntityTable<Flight>& flightData,
+                        const CompactGraph& graph, uint64_t journalMark);
+    bool saveAirports(const EntityTable<Airport>& airportData) const;
+    bool saveAircraft(const EntityTable<Aircraft>& aircraftData) const;
+    bool saveRoutes(const EntityTable<Route>& routeData) const;
+    bool saveFlights(const EntityTable<Flight>& flightData) const;
 
     // Undo helpers
     void pushUndo(const Action& action);
     std::vector<std::string> split(const std::string& str, char delimiter);
-    std::string trim(const std::string& str);
 
     // Serialization helpers for undo
     std::string serializeAirport(const Airport& a);
     Airport deserializeAirport(const std::string& data);
 };
+
+/**
+ * @brief Scoped bulk transaction: begins on construction, commits on
+ * destruction (or earlier through commit())
+ *
+ * Usage:
+ *   {
+ *       BulkTransaction bulk(DataStore::getInstance());
+ *       for (const Route& r : imported) store.addRoute(r);
+ *   }   // graph rebuilt and pending saves started here
+ */
+class BulkTransaction {
+public:
+    explicit BulkTransaction(DataStore& store) : store(store), open(true) {
+        store.beginBulk();
+    }
+    ~BulkTransaction() { commit(); }
+
+    BulkTransaction(const BulkTransaction&) = delete;
+    BulkTransaction& operator=(const BulkTransaction&) = delete;
+
+    void commit() {
+        if (open) {
+            open = false;
+            store.commitBulk();
+        }
+    }
+
+private:
+    DataStore& store;
+    bool open;
+};
+
 #endif // DATASTORE_H
@@ -1,4 +1,5 @@
 #include "Dijkstra.h"
+#include "SearchEngine.h"
 #include <queue>
 #include <map>
 #include <limits>
@@ -73,7 +74,7 @@ PathResult Dijkstra::findShortestPath(const Graph& graph,
         visited.insert(current);
 
         // Explore all neighbors
-        for (const auto& edge : graph.getNeighbors(current)) {
+        for (const Edge& edge : graph.neighbors(current)) {
             const std::string& neighbor = edge.destination;
             double newDist = distances[current] + edge.weight;
 
@@ -104,10 +105,33 @@ PathResult Dijkstra::findShortestPath(const Graph& graph,
     result.path = path;
     result.totalDistance = distances[end];
     result.totalCost = costs[end];
+    result.nodesExpanded = static_cast<int>(visited.size());
 
     return result;
 }
 
+PathResult Dijkstra::findShortestPath(const CompactGraph& graph,
+                                      const std::string& start,
+                                      const std::string& end) {
+    // One-shot engine; callers issuing many queries should keep their own
+    SearchEngine engine;
+    return engine.findShortestPath(graph, start, end);
+}
+
+PathResult Dijkstra::findShortestPathAStar(const CompactGraph& graph,
+                                           const std::string& start,
+                                           const std::string& end) {
+    SearchEngine engine;
+    return engine.findShortestPathAStar(graph, start, end);
+}
+
+PathResult Dijkstra::findShortestPathBidirectional(const CompactGraph& graph,
+                                                   const std::string& start,
+                                                   const std::string& end) {
+    SearchEngine engine;
+    return engine.findShortestPathBidirectional(graph, start, end);
+}
+
 std::vector<std::string> Dijkstra::reconstructPath(
     const std::map<std::string, std::string>& parent,
     const std::string& start,
@@ -1,6 +1,7 @@
 #ifndef DIJKSTRA_H
 #define DIJKSTRA_H
 #include "Graph.h"
+#include "CompactGraph.h"
 #include "PathResult.h"
 #include <string>
 
@@ -37,6 +38,36 @@ public:
                                        const std::string& start,
                                        const std::string& end);
 
+    /**
+     * Same search over a CSR snapshot (dense arrays, no string compares).
+     * Runs a one-shot SearchEngine; keep an engine for repeated queries.
+     * @param graph Compact flight network graph
+     * @param start Origin airport code
+     * @param end Destination airport code
+     * @return PathResult identical in shape to the Graph overload
+     */
+    static PathResult findShortestPath(const CompactGraph& graph,
+                                       const std::string& start,
+                                       const std::string& end);
+
+    /**
+     * A* search guided by great-circle distance to the destination.
+     * Same result as findShortestPath, usually far fewer nodes expanded
+     * (see PathResult::nodesExpanded). Needs coordinates on the graph.
+     */
+    static PathResult findShortestPathAStar(const CompactGraph& graph,
+                                            const std::string& start,
+                                            const std::string& end);
+
+    /**
+     * Bidirectional Dijkstra: forward and backward frontiers alternate
+     * until they meet. Same distance and cost as findShortestPath with
+     * roughly half the settled nodes on long queries.
+     */
+    static PathResult findShortestPathBidirectional(const CompactGraph& graph,
+                                                    const std::string& start,
+                                                    const std::string& end);
+
 private:
     // Reconstruct path from parent map
     static std::vector<std::string> reconstructPath(
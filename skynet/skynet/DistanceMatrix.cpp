@@ -0,0 +1,87 @@
+#include "DistanceMatrix.h"
+#include "SearchEngine.h"
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <thread>
+
+DistanceMatrix::Result DistanceMatrix::compute(const CompactGraph& graph,
+                                               const std::vector<std::string>& sources,
+                                               const std::vector<std::string>& targets,
+                                               unsigned threadCount) {
+    using NodeId = CompactGraph::NodeId;
+
+    Result result;
+    result.sources = sources;
+    result.targets = targets;
+
+    const size_t cells = sources.size() * targets.size();
+    result.distances.assign(cells, std::numeric_limits<double>::infinity());
+    result.costs.assign(cells, 0.0);
+    result.hops.assign(cells, -1);
+
+    // Resolve codes to ids once
+    std::vector<NodeId> sourceIds(sources.size());
+    std::vector<NodeId> targetIds(targets.size());
+    for (size_t i = 0; i < sources.size(); ++i) sourceIds[i] = graph.getNodeId(sources[i]);
+    for (size_t j = 0; j < targets.size(); ++j) targetIds[j] = graph.getNodeId(targets[j]);
+
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threadCount = static_cast<unsigned>(
+        std::min<size_t>(threadCount, std::max<size_t>(1, sources.size())));
+
+    // Workers claim rows from a shared counter; each row is written by
+    // exactly one thread, so the result needs no locking
+    std::atomic<size_t> nextRow(0);
+
+    auto worker = [&]() {
+        SearchEngine engine;
+
+        for (size_t i = nextRow++; i < sources.size(); i = nextRow++) {
+            NodeId source = sourceIds[i];
+            if (source == CompactGraph::INVALID_NODE) continue;
+
+            // One-to-all search fills the whole row
+            engine.search(graph, source, CompactGraph::INVALID_NODE);
+
+            for (size_t j = 0; j < targets.size(); ++j) {
+                NodeId target = targetIds[j];
+                if (target == CompactGraph::INVALID_NODE || !engine.isReached(target)) continue;
+
+                int hops = 0;
+                for (NodeId v = target; v != source; v = engine.getParent(v)) {
+                    ++hops;
+                }
+
+                size_t cell = result.index(i, j);
+                result.distances[cell] = engine.getDistance(target);
+                result.costs[cell] = engine.getCost(target);
+                result.hops[cell] = hops;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 1; t < threadCount; ++t) {
+        threads.emplace_back(worker);
+    }
+    worker();  // Calling thread works too
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    return result;
+}
+
+DistanceMatrix::Result DistanceMatrix::computeAllPairs(const CompactGraph& graph,
+                                                       unsigned threadCount) {
+    std::vector<std::string> codes;
+    codes.reserve(graph.getNodeCount());
+    for (CompactGraph::NodeId v = 0; v < graph.getNodeCount(); ++v) {
+        codes.push_back(graph.getNodeCode(v));
+    }
+    return compute(graph, codes, codes, threadCount);
+}
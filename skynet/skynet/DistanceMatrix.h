@@ -0,0 +1,59 @@
+#ifndef DISTANCEMATRIX_H
+#define DISTANCEMATRIX_H
+#include "CompactGraph.h"
+#include <string>
+#include <vector>
+
+/**
+ * @brief Batch origin x destination distance/cost/hop tables
+ *
+ * Why not call Dijkstra N² times?
+ * - Each point-to-point call starts from scratch and discards everything
+ *   it learned about the other destinations
+ * - One full search per source (one-to-all) yields the whole row at once:
+ *   N searches instead of N²
+ *
+ * Why threads?
+ * - Rows are independent; sources are handed out to worker threads,
+ *   each with its own SearchEngine workspace over the shared read-only
+ *   CompactGraph
+ *
+ * Result layout is dense row-major: entry (i, j) = sources[i] -> targets[j].
+ */
+class DistanceMatrix {
+public:
+    struct Result {
+        std::vector<std::string> sources;
+        std::vector<std::string> targets;
+        std::vector<double> distances;   // Infinity when unreachable
+        std::vector<double> costs;       // 0 when unreachable
+        std::vector<int> hops;           // Legs flown, -1 when unreachable
+
+        size_t index(size_t i, size_t j) const { return i * targets.size() + j; }
+        double getDistance(size_t i, size_t j) const { return distances[index(i, j)]; }
+        double getCost(size_t i, size_t j) const { return costs[index(i, j)]; }
+        int getHops(size_t i, size_t j) const { return hops[index(i, j)]; }
+        bool isReachable(size_t i, size_t j) const { return hops[index(i, j)] >= 0; }
+    };
+
+    /**
+     * Compute the full sources x targets table
+     * @param graph Compact flight network (shared read-only by all threads)
+     * @param sources Origin airport codes (rows)
+     * @param targets Destination airport codes (columns)
+     * @param threadCount Worker threads; 0 = hardware concurrency
+     * @return Dense matrix; unknown codes produce unreachable rows/columns
+     */
+    static Result compute(const CompactGraph& graph,
+                          const std::vector<std::string>& sources,
+                          const std::vector<std::string>& targets,
+                          unsigned threadCount = 0);
+
+    /**
+     * All-pairs table over every node in the graph
+     */
+    static Result computeAllPairs(const CompactGraph& graph,
+                                  unsigned threadCount = 0);
+};
+
+#endif // DISTANCEMATRIX_H
@@ -0,0 +1,506 @@
+#ifndef ENTITYTABLE_H
+#define ENTITYTABLE_H
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Keyed entity storage: pooled records plus an open-addressing
+ * hash index, addressed by stable integer handles
+ *
+ * Why not std::map<std::string, T>?
+ * - Every lookup walked a red-black tree, comparing strings and missing
+ *   the cache at each level; every record was a separate heap node
+ * - Here records live in a pool of fixed-size chunks, so iteration is a
+ *   mostly sequential sweep, and a lookup hashes the key once and
+ *   probes a flat bucket array
+ *
+ * Why handles?
+ * - A handle is the record's slot number in the pool plus that slot's
+ *   generation. The record does not move until it is erased, so callers
+ *   can keep handles or pointers instead of re-hashing strings
+ * - Freed slots are reused by later inserts, but erasing bumps the
+ *   slot's generation: a handle to the erased record never resolves to
+ *   the new one. isLive() turns false, at() returns end() and get()
+ *   throws std::out_of_range
+ *
+ * Why chunks instead of one vector?
+ * - Growing a vector would move every record and invalidate pointers
+ *   handed out by DataStore::getAirport() and friends
+ *
+ * Keys:
+ * - Each key string is stored once, in its slot (value_type mirrors
+ *   std::map: pair<const std::string, T>), and the index refers to it
+ *   by handle. Lookups take std::string_view, so no temporary strings
+ * - findJoined() looks up composite keys such as route ids ("JFK-LHR")
+ *   from their parts without building the string
+ *
+ * The interface follows std::map where the two overlap (find, end,
+ * operator[], try_emplace, erase, structured bindings on iteration), but
+ * iteration runs in slot order, not key order. try_emplace() (and so
+ * operator[] and insert_or_assign()) reuses the most recently freed
+ * slot, so after deletions slot order is no longer insertion order.
+ * Listings and files that users see take valuesByKey() instead.
+ */
+template <typename T>
+class EntityTable {
+public:
+    using Handle = uint64_t;   // Generation in the high 32 bits, slot below
+    using key_type = std::string;
+    using mapped_type = T;
+    using value_type = std::pair<const std::string, T>;
+
+    static constexpr Handle INVALID_HANDLE = std::numeric_limits<Handle>::max();
+
+    template <bool IsConst>
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = EntityTable::value_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<IsConst, const value_type&, value_type&>;
+        using pointer = std::conditional_t<IsConst, const value_type*, value_type*>;
+        using TablePtr = std::conditional_t<IsConst, const EntityTable*, EntityTable*>;
+
+        Iterator() : table(nullptr), position(0) {}
+        Iterator(TablePtr table, uint32_t position) : table(table), position(position) {
+            skipFree();
+        }
+
+        // iterator -> const_iterator
+        template <bool WasConst, typename = std::enable_if_t<IsConst && !WasConst>>
+        Iterator(const Iterator<WasConst>& other)
+            : table(other.table), position(other.position) {}
+
+        reference operator*() const { return *table->slot(position); }
+        pointer operator->() const { return &*table->slot(position); }
+        Handle handle() const { return table->handleAt(position); }
+
+        Iterator& operator++() {
+            ++position;
+            skipFree();
+            return *this;
+        }
+        Iterator operator++(int) {
+            Iterator before = *this;
+            ++*this;
+            return before;
+        }
+
+        bool operator==(const Iterator& other) const { return position == other.position; }
+        bool operator!=(const Iterator& other) const { return position != other.position; }
+
+    private:
+        template <bool> friend class Iterator;
+        friend class EntityTable;
+
+        void skipFree() {
+            while (position < table->slotCount && !table->slot(position)) {
+                ++position;
+            }
+        }
+
+        TablePtr table;
+        uint32_t position;   // Slot index
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    // The records without their keys: for (const T& record : table.values())
+    template <bool IsConst>
+    class Values {
+    public:
+        class iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using reference = std::conditional_t<IsConst, const T&, T&>;
+            using pointer = std::conditional_t<IsConst, const T*, T*>;
+
+            explicit iterator(Iterator<IsConst> position) : position(position) {}
+
+            reference operator*() const { return position->second; }
+            pointer operator->() const { return &position->second; }
+            Handle handle() const { return position.handle(); }
+
+            iterator& operator++() {
+                ++position;
+                return *this;
+            }
+            iterator operator++(int) {
+                iterator before = *this;
+                ++position;
+                return before;
+            }
+
+            bool operator==(const iterator& other) const { return position == other.position; }
+            bool operator!=(const iterator& other) const { return position != other.position; }
+
+        private:
+            Iterator<IsConst> position;
+        };
+
+        Values(Iterator<IsConst> first, Iterator<IsConst> last) : first(first), last(last) {}
+
+        iterator begin() const { return iterator(first); }
+        iterator end() const { return iterator(last); }
+        bool empty() const { return first == last; }
+
+    private:
+        Iterator<IsConst> first;
+        Iterator<IsConst> last;
+    };
+
+    using value_range = Values<false>;
+    using const_value_range = Values<true>;
+
+    EntityTable() : slotCount(0), liveCount(0), usedBuckets(0) {}
+
+    EntityTable(const EntityTable& other) : EntityTable() { *this = other; }
+
+    EntityTable& operator=(const EntityTable& other) {
+        if (this == &other) return *this;
+        clear();
+        chunks.resize(other.chunks.size());
+        for (size_t c = 0; c < other.chunks.size(); ++c) {
+            chunks[c] = std::make_unique<Slot[]>(CHUNK_SIZE);
+            for (size_t i = 0; i < CHUNK_SIZE; ++i) {
+                if (other.chunks[c][i]) chunks[c][i].emplace(*other.chunks[c][i]);
+            }
+        }
+        slotCount = other.slotCount;
+        liveCount = other.liveCount;
+        freeSlots = other.freeSlots;
+        generations = other.generations;
+        buckets = other.buckets;
+        usedBuckets = other.usedBuckets;
+        return *this;
+    }
+
+    EntityTable(EntityTable&& other) noexcept : EntityTable() { swap(other); }
+    EntityTable& operator=(EntityTable&& other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    void swap(EntityTable& other) noexcept {
+        chunks.swap(other.chunks);
+        std::swap(slotCount, other.slotCount);
+        std::swap(liveCount, other.liveCount);
+        freeSlots.swap(other.freeSlots);
+        generations.swap(other.generations);
+        buckets.swap(other.buckets);
+        std::swap(usedBuckets, other.usedBuckets);
+    }
+
+    size_t size() const { return liveCount; }
+    bool empty() const { return liveCount == 0; }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, slotCount); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, slotCount); }
+    value_range values() { return value_range(begin(), end()); }
+    const_value_range values() const { return const_value_range(begin(), end()); }
+
+    // The records in key order, as std::map iterated them (sorts on
+    // every call). Pointers stay valid until their record is erased
+    std::vector<const T*> valuesByKey() const {
+        std::vector<const value_type*> entries;
+        entries.reserve(liveCount);
+        for (const value_type& entry : *this) entries.push_back(&entry);
+        std::sort(entries.begin(), entries.end(),
+                  [](const value_type* a, const value_type* b) { return a->first < b->first; });
+
+        std::vector<const T*> records;
+        records.reserve(entries.size());
+        for (const value_type* entry : entries) records.push_back(&entry->second);
+        return records;
+    }
+
+    // ---- Lookup ----
+
+    Handle findHandle(std::string_view key) const { return handleOrInvalid(findIndex(key)); }
+
+    // Key formed as first + separator + second (e.g. route ids)
+    Handle findJoinedHandle(std::string_view first, char separator, std::string_view second) const {
+        return handleOrInvalid(findJoinedIndex(first, separator, second));
+    }
+
+    iterator find(std::string_view key) { return iterator(this, positionOf(findIndex(key))); }
+    const_iterator find(std::string_view key) const {
+        return const_iterator(this, positionOf(findIndex(key)));
+    }
+    iterator findJoined(std::string_view first, char separator, std::string_view second) {
+        return iterator(this, positionOf(findJoinedIndex(first, separator, second)));
+    }
+    const_iterator findJoined(std::string_view first, char separator,
+                              std::string_view second) const {
+        return const_iterator(this, positionOf(findJoinedIndex(first, separator, second)));
+    }
+    bool contains(std::string_view key) const { return findIndex(key) != NO_INDEX; }
+
+    // ---- Handle access ----
+
+    // False for INVALID_HANDLE and for handles whose record was erased
+    bool isLive(Handle handle) const {
+        const uint32_t index = indexOf(handle);
+        return index < slotCount && slot(index) && generations[index] == generationOf(handle);
+    }
+
+    // @throws std::out_of_range unless isLive(handle)
+    T& get(Handle handle) { return checkedSlot(handle)->second; }
+    const T& get(Handle handle) const { return checkedSlot(handle)->second; }
+    const std::string& keyOf(Handle handle) const { return checkedSlot(handle)->first; }
+
+    // end() unless isLive(handle)
+    iterator at(Handle handle) {
+        return isLive(handle) ? iterator(this, indexOf(handle)) : end();
+    }
+    const_iterator at(Handle handle) const {
+        return isLive(handle) ? const_iterator(this, indexOf(handle)) : end();
+    }
+
+    // ---- Modification ----
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(std::string_view key, Args&&... args) {
+        const uint64_t hash = hashBytes(FNV_OFFSET, key);
+        uint32_t existing = lookup(hash, [key](const std::string& stored) { return stored == key; });
+        if (existing != NO_INDEX) {
+            return {iterator(this, existing), false};
+        }
+
+        uint32_t index = allocate();
+        slot(index).emplace(std::piecewise_construct, std::forward_as_tuple(key),
+                            std::forward_as_tuple(std::forward<Args>(args)...));
+        ++liveCount;
+        insertIndex(hash, index);
+        return {iterator(this, index), true};
+    }
+
+    template <typename V>
+    std::pair<iterator, bool> insert_or_assign(std::string_view key, V&& value) {
+        auto result = try_emplace(key, std::forward<V>(value));
+        if (!result.second) {
+            result.first->second = std::forward<V>(value);
+        }
+        return result;
+    }
+
+    T& operator[](std::string_view key) { return try_emplace(key).first->second; }
+
+    size_t erase(std::string_view key) {
+        uint32_t index = findIndex(key);
+        if (index == NO_INDEX) return 0;
+        release(index);
+        return 1;
+    }
+
+    // @return Iterator to the next record
+    iterator erase(const_iterator it) {
+        uint32_t index = it.position;
+        release(index);
+        return iterator(this, index + 1);
+    }
+
+    void clear() {
+        // Slots restart from 0; bumping every generation keeps handles
+        // from before the clear dead
+        for (uint32_t& generation : generations) ++generation;
+        chunks.clear();
+        slotCount = 0;
+        liveCount = 0;
+        freeSlots.clear();
+        buckets.clear();
+        usedBuckets = 0;
+    }
+
+    // Size the index for n records up front (bulk loads)
+    void reserve(size_t n) {
+        size_t wanted = MIN_BUCKETS;
+        while (wanted * MAX_LOAD_NUM < n * MAX_LOAD_DEN) wanted *= 2;
+        if (wanted > buckets.size()) rehash(wanted);
+    }
+
+private:
+    using Slot = std::optional<value_type>;
+
+    static constexpr uint32_t NO_INDEX = std::numeric_limits<uint32_t>::max();
+
+    // Bucket states in Bucket::index besides real slot indexes
+    static constexpr uint32_t EMPTY = NO_INDEX;
+    static constexpr uint32_t TOMBSTONE = NO_INDEX - 1;
+
+    struct Bucket {
+        uint32_t index;
+        uint32_t tag;   // Low hash bits: most mismatches never touch the key
+    };
+
+    static constexpr size_t CHUNK_BITS = 8;
+    static constexpr size_t CHUNK_SIZE = size_t(1) << CHUNK_BITS;
+    static constexpr size_t MIN_BUCKETS = 16;
+    static constexpr size_t MAX_LOAD_NUM = 7;   // Max load 0.7, tombstones included
+    static constexpr size_t MAX_LOAD_DEN = 10;
+    static constexpr uint64_t FNV_OFFSET = 14695981039346656037ull;
+
+    // FNV-1a, continued from hash so joined keys hash like their concatenation
+    static uint64_t hashBytes(uint64_t hash, std::string_view bytes) {
+        for (unsigned char c : bytes) {
+            hash ^= c;
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    // Fold high bits in; FNV's low bits alone cluster on short keys
+    static size_t bucketOf(uint64_t hash, size_t mask) {
+        return static_cast<size_t>(hash ^ (hash >> 29) ^ (hash >> 47)) & mask;
+    }
+
+    static uint32_t indexOf(Handle handle) { return static_cast<uint32_t>(handle); }
+    static uint32_t generationOf(Handle handle) { return static_cast<uint32_t>(handle >> 32); }
+
+    Handle handleAt(uint32_t index) const {
+        return (static_cast<Handle>(generations[index]) << 32) | index;
+    }
+    Handle handleOrInvalid(uint32_t index) const {
+        return index == NO_INDEX ? INVALID_HANDLE : handleAt(index);
+    }
+    // Iterator position for a lookup result: slotCount (end) if not found
+    uint32_t positionOf(uint32_t index) const { return index == NO_INDEX ? slotCount : index; }
+
+    Slot& slot(uint32_t index) { return chunks[index >> CHUNK_BITS][index & (CHUNK_SIZE - 1)]; }
+    const Slot& slot(uint32_t index) const {
+        return chunks[index >> CHUNK_BITS][index & (CHUNK_SIZE - 1)];
+    }
+
+    const Slot& checkedSlot(Handle handle) const {
+        if (!isLive(handle)) {
+            throw std::out_of_range("EntityTable: handle does not name a live record");
+        }
+        return slot(indexOf(handle));
+    }
+    Slot& checkedSlot(Handle handle) {
+        return const_cast<Slot&>(static_cast<const EntityTable*>(this)->checkedSlot(handle));
+    }
+
+    uint32_t findIndex(std::string_view key) const {
+        return lookup(hashBytes(FNV_OFFSET, key),
+                      [key](const std::string& stored) { return stored == key; });
+    }
+
+    uint32_t findJoinedIndex(std::string_view first, char separator, std::string_view second) const {
+        uint64_t hash = hashBytes(hashBytes(hashBytes(FNV_OFFSET, first),
+                                            std::string_view(&separator, 1)), second);
+        return lookup(hash, [&](const std::string& stored) {
+            return stored.size() == first.size() + 1 + second.size() &&
+                   stored.compare(0, first.size(), first) == 0 &&
+                   stored[first.size()] == separator &&
+                   stored.compare(first.size() + 1, std::string::npos, second) == 0;
+        });
+    }
+
+    template <typename KeyEquals>
+    uint32_t lookup(uint64_t hash, KeyEquals keyEquals) const {
+        if (buckets.empty()) return NO_INDEX;
+
+        const size_t mask = buckets.size() - 1;
+        const uint32_t tag = static_cast<uint32_t>(hash);
+        for (size_t b = bucketOf(hash, mask);; b = (b + 1) & mask) {
+            const Bucket& bucket = buckets[b];
+            if (bucket.index == EMPTY) return NO_INDEX;
+            if (bucket.index != TOMBSTONE && bucket.tag == tag &&
+                keyEquals(slot(bucket.index)->first)) {
+                return bucket.index;
+            }
+        }
+    }
+
+    uint32_t allocate() {
+        if (!freeSlots.empty()) {
+            uint32_t index = freeSlots.back();
+            freeSlots.pop_back();
+            return index;
+        }
+        if ((slotCount >> CHUNK_BITS) == chunks.size()) {
+            chunks.push_back(std::make_unique<Slot[]>(CHUNK_SIZE));
+        }
+        if (slotCount == generations.size()) {
+            generations.push_back(0);
+        }
+        return slotCount++;
+    }
+
+    void insertIndex(uint64_t hash, uint32_t index) {
+        if ((usedBuckets + 1) * MAX_LOAD_DEN > buckets.size() * MAX_LOAD_NUM) {
+            // Grow if live records need it, otherwise just sweep tombstones
+            size_t wanted = std::max(MIN_BUCKETS, buckets.size());
+            while (wanted * MAX_LOAD_NUM < (liveCount + 1) * MAX_LOAD_DEN * 2) wanted *= 2;
+            rehash(wanted);
+        }
+
+        const size_t mask = buckets.size() - 1;
+        size_t b = bucketOf(hash, mask);
+        while (buckets[b].index != EMPTY && buckets[b].index != TOMBSTONE) {
+            b = (b + 1) & mask;
+        }
+        if (buckets[b].index == EMPTY) ++usedBuckets;
+        buckets[b] = Bucket{index, static_cast<uint32_t>(hash)};
+    }
+
+    void release(uint32_t index) {
+        const uint64_t hash = hashBytes(FNV_OFFSET, slot(index)->first);
+        const size_t mask = buckets.size() - 1;
+        size_t b = bucketOf(hash, mask);
+        while (buckets[b].index != index) {
+            b = (b + 1) & mask;
+        }
+        buckets[b].index = TOMBSTONE;
+
+        slot(index).reset();
+        --liveCount;
+        ++generations[index];
+        freeSlots.push_back(index);
+    }
+
+    void rehash(size_t bucketCount) {
+        buckets.assign(bucketCount, Bucket{EMPTY, 0});
+        usedBuckets = 0;
+
+        const size_t mask = bucketCount - 1;
+        for (uint32_t index = 0; index < slotCount; ++index) {
+            if (!slot(index)) continue;
+            const uint64_t hash = hashBytes(FNV_OFFSET, slot(index)->first);
+            size_t b = bucketOf(hash, mask);
+            while (buckets[b].index != EMPTY) {
+                b = (b + 1) & mask;
+            }
+            buckets[b] = Bucket{index, static_cast<uint32_t>(hash)};
+            ++usedBuckets;
+        }
+    }
+
+    std::vector<std::unique_ptr<Slot[]>> chunks;
+    uint32_t slotCount;
+    size_t liveCount;
+    std::vector<uint32_t> freeSlots;
+    std::vector<uint32_t> generations;   // Per slot, bumped on every erase
+    std::vector<Bucket> buckets;
+    size_t usedBuckets;
+};
+
+#endif // ENTITYTABLE_H
@@ -0,0 +1,39 @@
+#ifndef FILEUTIL_H
+#define FILEUTIL_H
+#include <cstdio>
+#include <string>
+
+/**
+ * @brief Small portable helpers for durable file I/O
+ *
+ * Why not just fflush?
+ * - fflush only hands the bytes to the OS; after a power loss they can
+ *   still be gone. syncFile() also asks the OS to push them to the disk
+ *   (fsync on POSIX, _commit on Windows)
+ *
+ * Why sync the directory too?
+ * - A rename is itself a change to the directory. On POSIX it only
+ *   survives a crash once the directory has been synced as well
+ */
+class FileUtil {
+public:
+    /**
+     * Flush stdio buffers and force the file's data to stable storage
+     * @return false if either step fails
+     */
+    static bool syncFile(std::FILE* file);
+
+    /**
+     * Atomically replace target with source (readers see the old file or
+     * the new one, never a mix). source is gone afterwards.
+     */
+    static bool replaceFile(const std::string& source, const std::string& target);
+
+    /**
+     * Make renames and creations in path's directory durable
+     * (no-op on Windows, where replaceFile writes through)
+     */
+    static bool syncParentDirectory(const std::string& path);
+};
+
+#endif // FILEUTIL_H
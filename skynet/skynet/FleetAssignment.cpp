@@ -0,0 +1,400 @@
+#include "FleetAssignment.h"
+#include "DataStore.h"
+#include "Scheduling.h"
+#include "TimeUtil.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+
+namespace {
+
+// Cost of an infeasible pair: above any slice's real fuel bill, so the
+// matching never trades a covered flight for cheaper fuel
+const double INFEASIBLE = 1e12;
+
+// Smaller cost matrices are filled on the calling thread
+const size_t PARALLEL_CELLS = 16384;
+
+struct Slot {
+    int64_t end;
+    std::string origin;
+    std::string destination;
+};
+
+// One aircraft's booked and newly assigned flights, by start minute
+struct AircraftState {
+    const Aircraft* aircraft;
+    std::multimap<int64_t, Slot> schedule;
+    int64_t longestWindow = 0;
+
+    void add(int64_t start, int64_t end, std::string origin, std::string destination) {
+        schedule.emplace(start, Slot{end, std::move(origin), std::move(destination)});
+        longestWindow = std::max(longestWindow, end - start);
+    }
+};
+
+int64_t minutesOn(const Flight& flight, const Aircraft& aircraft) {
+    double hours = aircraft.cruiseSpeed > 0.0 ? flight.totalDistance / aircraft.cruiseSpeed
+                                              : flight.estimatedTime;
+    return static_cast<int64_t>(std::llround(hours * 60.0));
+}
+
+// Can the aircraft fly origin -> destination over [start, end)?
+bool fits(const AircraftState& state, int64_t start, int64_t end,
+          const std::string& origin, const std::string& destination) {
+    const auto& schedule = state.schedule;
+
+    // Anything overlapping starts after start - longestWindow
+    for (auto it = schedule.lower_bound(start - state.longestWindow + 1);
+         it != schedule.end() && it->first < end; ++it) {
+        if (it->second.end > start) {
+            return false;
+        }
+    }
+
+    // The aircraft must be at the origin, and its next flight must leave
+    // from where this one lands
+    auto next = schedule.lower_bound(start);
+    if (next != schedule.begin() && std::prev(next)->second.destination != origin) {
+        return false;
+    }
+    return next == schedule.end() || next->second.origin == destination;
+}
+
+/**
+ * Load the part of an aircraft's schedule a plan over departures
+ * [horizonStart, horizonEnd] can touch: windows starting inside it or
+ * still open at its start, plus the last window before and the first
+ * after for positioning
+ */
+void loadSchedule(AircraftState& state, const std::vector<const Flight*>& flights,
+                  int64_t horizonStart, int64_t horizonEnd) {
+    const Flight* before = nullptr;
+    const Flight* after = nullptr;
+    int64_t beforeStart = 0, beforeEnd = 0, afterStart = 0, afterEnd = 0;
+
+    for (const Flight* flight : flights) {
+        int64_t start, end;
+        if (flight->status == "CANCELLED" || !Scheduling::getTimeWindow(*flight, start, end)) {
+            continue;
+        }
+
+        if (start > horizonEnd) {
+            if (!after || start < afterStart) {
+                after = flight;
+                afterStart = start;
+                afterEnd = end;
+            }
+        } else if (start >= horizonStart || end > horizonStart) {
+            state.add(start, end, flight->getOrigin(), flight->getDestination());
+        } else if (!before || start > beforeStart) {
+            before = flight;
+            beforeStart = start;
+            beforeEnd = end;
+        }
+    }
+
+    if (before) state.add(beforeStart, beforeEnd, before->getOrigin(), before->getDestination());
+    if (after) state.add(afterStart, afterEnd, after->getOrigin(), after->getDestination());
+}
+
+// Departure minutes of the planned flights (NO_TIME if unparseable)
+std::vector<int64_t> parseDepartures(const std::vector<Flight>& planned,
+                                     int64_t& horizonStart, int64_t& horizonEnd) {
+    std::vector<int64_t> starts(planned.size());
+    horizonStart = TimeUtil::MAX_TIME;
+    horizonEnd = TimeUtil::NO_TIME;
+    for (size_t i = 0; i < planned.size(); ++i) {
+        starts[i] = TimeUtil::parseMinutes(planned[i].departureTime);
+        if (starts[i] != TimeUtil::NO_TIME) {
+            horizonStart = std::min(horizonStart, starts[i]);
+            horizonEnd = std::max(horizonEnd, starts[i]);
+        }
+    }
+    return starts;
+}
+
+// Fill rows [0, rows) with `fill(row)`, on several threads if worth it
+template <typename Fill>
+void forEachRow(size_t rows, size_t cells, unsigned threadCount, const Fill& fill) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (cells < PARALLEL_CELLS) {
+        threadCount = 1;
+    }
+    threadCount = static_cast<unsigned>(std::min<size_t>(threadCount, std::max<size_t>(1, rows)));
+
+    // Each row is written by exactly one thread, so no locking
+    std::atomic<size_t> nextRow(0);
+    auto worker = [&]() {
+        for (size_t row = nextRow++; row < rows; row = nextRow++) {
+            fill(row);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 1; t < threadCount; ++t) {
+        threads.emplace_back(worker);
+    }
+    worker();  // Calling thread works too
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+FleetAssignment::Result solve(const std::vector<Flight>& planned,
+                              const std::vector<int64_t>& starts,
+                              std::vector<AircraftState>& fleet,
+                              const FleetAssignment::Options& options) {
+    FleetAssignment::Result result;
+    result.assignments.resize(planned.size());
+
+    std::vector<size_t> order;
+    order.reserve(planned.size());
+    for (size_t i = 0; i < planned.size(); ++i) {
+        if (starts[i] != TimeUtil::NO_TIME) order.push_back(i);
+    }
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return starts[a] != starts[b] ? starts[a] < starts[b] : a < b;
+    });
+
+    auto seatsNeeded = [&](size_t i) {
+        return i < options.requiredSeats.size() ? options.requiredSeats[i] : 0;
+    };
+
+    const int64_t batchMinutes = std::max(1, options.batchMinutes);
+    const size_t cols = fleet.size();
+    std::vector<double> costs;
+    std::vector<double> reduced;
+    std::vector<size_t> liveRows, liveCols;
+
+    for (size_t first = 0; first < order.size();) {
+        size_t last = first;
+        while (last < order.size() && starts[order[last]] < starts[order[first]] + batchMinutes) {
+            ++last;
+        }
+        const size_t rows = last - first;
+
+        // Fuel cost of every (flight, aircraft) pair in the slice
+        costs.assign(rows * cols, INFEASIBLE);
+        forEachRow(rows, rows * cols, options.threadCount, [&](size_t row) {
+            const size_t i = order[first + row];
+            const Flight& flight = planned[i];
+            const std::string origin = flight.getOrigin();
+            const std::string destination = flight.getDestination();
+            for (size_t col = 0; col < cols; ++col) {
+                const Aircraft& aircraft = *fleet[col].aircraft;
+                if (aircraft.capacity < seatsNeeded(i)) continue;
+
+                int64_t end = starts[i] + minutesOn(flight, aircraft) + Scheduling::TURNAROUND_MINUTES;
+                if (fits(fleet[col], starts[i], end, origin, destination)) {
+                    costs[row * cols + col] = flight.totalDistance * aircraft.fuelConsumption;
+                }
+            }
+        });
+
+        // Solve only over flights and aircraft with a feasible pair
+        std::vector<char> colUsed(cols, 0);
+        liveRows.clear();
+        for (size_t row = 0; row < rows; ++row) {
+            bool any = false;
+            for (size_t col = 0; col < cols; ++col) {
+                if (costs[row * cols + col] < INFEASIBLE) {
+                    colUsed[col] = 1;
+                    any = true;
+                }
+            }
+            if (any) liveRows.push_back(row);
+        }
+        liveCols.clear();
+        for (size_t col = 0; col < cols; ++col) {
+            if (colUsed[col]) liveCols.push_back(col);
+        }
+
+        if (!liveRows.empty()) {
+            // The method wants rows <= cols; transpose a tall slice
+            const bool transposed = liveRows.size() > liveCols.size();
+            const size_t n = transposed ? liveCols.size() : liveRows.size();
+            const size_t m = transposed ? liveRows.size() : liveCols.size();
+            reduced.resize(n * m);
+            for (size_t r = 0; r < liveRows.size(); ++r) {
+                for (size_t c = 0; c < liveCols.size(); ++c) {
+                    double cost = costs[liveRows[r] * cols + liveCols[c]];
+                    reduced[transposed ? c * m + r : r * m + c] = cost;
+                }
+            }
+
+            std::vector<int> match = FleetAssignment::solveAssignment(reduced, n, m);
+            for (size_t k = 0; k < n; ++k) {
+                if (match[k] < 0) continue;
+                size_t row = liveRows[transposed ? match[k] : k];
+                size_t col = liveCols[transposed ? k : match[k]];
+                double cost = costs[row * cols + col];
+                if (cost >= INFEASIBLE) continue;
+
+                // Commit, so later slices see the aircraft's new position
+                const size_t i = order[first + row];
+                const Flight& flight = planned[i];
+                AircraftState& state = fleet[col];
+                int64_t minutes = minutesOn(flight, *state.aircraft);
+                state.add(starts[i], starts[i] + minutes + Scheduling::TURNAROUND_MINUTES,
+                          flight.getOrigin(), flight.getDestination());
+
+                FleetAssignment::Assignment& assignment = result.assignments[i];
+                assignment.aircraftId = state.aircraft->id;
+                assignment.fuelCost = cost;
+                assignment.estimatedTime = minutes / 60.0;
+                result.totalFuelCost += cost;
+                ++result.assignedCount;
+            }
+        }
+
+        first = last;
+    }
+
+    return result;
+}
+
+void sortById(std::vector<AircraftState>& fleet) {
+    std::sort(fleet.begin(), fleet.end(), [](const AircraftState& a, const AircraftState& b) {
+        return a.aircraft->id < b.aircraft->id;
+    });
+}
+
+} // namespace
+
+FleetAssignment::Result FleetAssignment::assign(const std::vector<Flight>& planned,
+                                                const DataStore& store,
+                                                const Options& options) {
+    int64_t horizonStart, horizonEnd;
+    std::vector<int64_t> starts = parseDepartures(planned, horizonStart, horizonEnd);
+
+    std::vector<AircraftState> fleet;
+    for (const Aircraft& aircraft : store.viewAircraft()) {
+        if (!aircraft.isAvailable()) continue;
+        fleet.push_back(AircraftState{&aircraft, {}, 0});
+        if (horizonStart <= horizonEnd) {
+            loadSchedule(fleet.back(), store.getFlightsByAircraft(aircraft.id),
+                         horizonStart, horizonEnd);
+        }
+    }
+    sortById(fleet);
+
+    return solve(planned, starts, fleet, options);
+}
+
+FleetAssignment::Result FleetAssignment::assign(const std::vector<Flight>& planned,
+                                                const std::vector<Aircraft>& fleetList,
+                                                const std::vector<Flight>& existing,
+                                                const Options& options) {
+    int64_t horizonStart, horizonEnd;
+    std::vector<int64_t> starts = parseDepartures(planned, horizonStart, horizonEnd);
+
+    std::unordered_map<std::string_view, std::vector<const Flight*>> byAircraft;
+    for (const Flight& flight : existing) {
+        byAircraft[flight.aircraftId].push_back(&flight);
+    }
+
+    std::vector<AircraftState> fleet;
+    for (const Aircraft& aircraft : fleetList) {
+        if (!aircraft.isAvailable()) continue;
+        fleet.push_back(AircraftState{&aircraft, {}, 0});
+        auto it = byAircraft.find(aircraft.id);
+        if (it != byAircraft.end() && horizonStart <= horizonEnd) {
+            loadSchedule(fleet.back(), it->second, horizonStart, horizonEnd);
+        }
+    }
+    sortById(fleet);
+
+    return solve(planned, starts, fleet, options);
+}
+
+std::vector<int> FleetAssignment::solveAssignment(const std::vector<double>& costs,
+                                                  size_t rows, size_t cols) {
+    std::vector<int> assignment(rows, -1);
+    if (rows == 0 || cols == 0) {
+        return assignment;
+    }
+
+    // Transpose so rows <= cols, then map the answer back
+    if (rows > cols) {
+        std::vector<double> transposed(rows * cols);
+        for (size_t i = 0; i < rows; ++i) {
+            for (size_t j = 0; j < cols; ++j) {
+                transposed[j * rows + i] = costs[i * cols + j];
+            }
+        }
+        std::vector<int> byColumn = solveAssignment(transposed, cols, rows);
+        for (size_t j = 0; j < cols; ++j) {
+            assignment[byColumn[j]] = static_cast<int>(j);
+        }
+        return assignment;
+    }
+
+    // Shortest augmenting paths with row/column potentials u and v.
+    // Index 0 is a virtual column; rowOf[j] is the row (1-based) holding
+    // column j, 0 if free.
+    const double INF = std::numeric_limits<double>::infinity();
+    std::vector<double> u(rows + 1, 0.0), v(cols + 1, 0.0), minReduced(cols + 1);
+    std::vector<size_t> rowOf(cols + 1, 0), previous(cols + 1, 0);
+    std::vector<char> visited(cols + 1);
+
+    for (size_t i = 1; i <= rows; ++i) {
+        rowOf[0] = i;
+        size_t column = 0;
+        std::fill(minReduced.begin(), minReduced.end(), INF);
+        std::fill(visited.begin(), visited.end(), 0);
+
+        // Grow the alternating tree until it reaches a free column
+        do {
+            visited[column] = 1;
+            const size_t row = rowOf[column];
+            const double* rowCosts = &costs[(row - 1) * cols];
+            double delta = INF;
+            size_t nextColumn = 0;
+            for (size_t j = 1; j <= cols; ++j) {
+                if (visited[j]) continue;
+                double reducedCost = rowCosts[j - 1] - u[row] - v[j];
+                if (reducedCost < minReduced[j]) {
+                    minReduced[j] = reducedCost;
+                    previous[j] = column;
+                }
+                if (minReduced[j] < delta) {
+                    delta = minReduced[j];
+                    nextColumn = j;
+                }
+            }
+            for (size_t j = 0; j <= cols; ++j) {
+                if (visited[j]) {
+                    u[rowOf[j]] += delta;
+                    v[j] -= delta;
+                } else {
+                    minReduced[j] -= delta;
+                }
+            }
+            column = nextColumn;
+        } while (rowOf[column] != 0);
+
+        // Flip the augmenting path
+        do {
+            size_t prior = previous[column];
+            rowOf[column] = rowOf[prior];
+            column = prior;
+        } while (column != 0);
+    }
+
+    for (size_t j = 1; j <= cols; ++j) {
+        if (rowOf[j] != 0) {
+            assignment[rowOf[j] - 1] = static_cast<int>(j - 1);
+        }
+    }
+    return assignment;
+}
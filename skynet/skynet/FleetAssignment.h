@@ -0,0 +1,91 @@
+#ifndef FLEETASSIGNMENT_H
+#define FLEETASSIGNMENT_H
+#include "Flight.h"
+#include "aircraft.h"
+#include <string>
+#include <vector>
+
+class DataStore;
+
+/**
+ * @brief Assigns aircraft to planned flights at minimum total fuel cost
+ *
+ * Why min-cost matching?
+ * - Picking aircraft by hand, or greedily flight by flight, burns the
+ *   efficient aircraft on whichever flight comes first. Planned flights
+ *   are sorted by departure and cut into slices of batchMinutes; each
+ *   slice is one assignment problem (flights x aircraft, cost = fuel
+ *   burned: totalDistance x fuelConsumption) solved exactly with the
+ *   Hungarian method
+ * - Infeasible pairs cost a penalty larger than any real fuel bill, so
+ *   the matching first covers as many flights as it can, then spends as
+ *   little fuel as possible on them
+ * - Slices are committed in departure order. Each slice sees the
+ *   aircraft where the previous slices left them, so chains of flights
+ *   stay consistent; within a slice an aircraft takes at most one flight
+ *
+ * Which pairs are feasible?
+ * - The aircraft is available (Aircraft::isAvailable) and, if seats are
+ *   required, large enough
+ * - Its window on the aircraft (departure to arrival at cruiseSpeed, plus
+ *   Scheduling::TURNAROUND_MINUTES) overlaps none of the aircraft's
+ *   booked or newly assigned flights
+ * - Positioning: the aircraft's previous flight lands at the origin and
+ *   its next flight leaves from the destination. An aircraft with no
+ *   earlier flight can start anywhere
+ *
+ * Why threads?
+ * - Each cost-matrix row (one flight against the whole fleet) is
+ *   independent and read-only; rows are handed out to worker threads
+ *   like DistanceMatrix rows. The matching itself is sequential
+ *
+ * Existing flights count unless CANCELLED; each aircraft's booked
+ * schedule is assumed free of conflicts (Scheduling::detectConflicts).
+ */
+class FleetAssignment {
+public:
+    struct Options {
+        int batchMinutes;                // Departure slice solved as one matching
+        unsigned threadCount;            // Cost-matrix workers; 0 = hardware concurrency
+        std::vector<int> requiredSeats;  // Per planned flight, same order; empty = any size
+
+        Options() : batchMinutes(60), threadCount(0) {}
+    };
+
+    struct Assignment {
+        std::string aircraftId;      // Empty: no feasible aircraft
+        double fuelCost = 0.0;       // totalDistance x fuelConsumption
+        double estimatedTime = 0.0;  // Hours at the aircraft's cruise speed
+    };
+
+    struct Result {
+        std::vector<Assignment> assignments;   // One per planned flight, same order
+        double totalFuelCost = 0.0;
+        size_t assignedCount = 0;
+    };
+
+    /**
+     * Assign the store's fleet around its booked flights
+     * @param planned Flights to assign; aircraftId is ignored. Flights
+     *        whose departure time does not parse stay unassigned
+     */
+    static Result assign(const std::vector<Flight>& planned, const DataStore& store,
+                         const Options& options = Options());
+
+    // Same against an explicit fleet and schedule
+    static Result assign(const std::vector<Flight>& planned,
+                         const std::vector<Aircraft>& fleet,
+                         const std::vector<Flight>& existing,
+                         const Options& options = Options());
+
+    /**
+     * Minimum-cost assignment of rows to columns (Hungarian method,
+     * O(rows^2 x cols))
+     * @param costs Dense row-major rows x cols matrix
+     * @return Column of each row, or -1 if rows > cols left it out
+     */
+    static std::vector<int> solveAssignment(const std::vector<double>& costs,
+                                            size_t rows, size_t cols);
+};
+
+#endif // FLEETASSIGNMENT_H
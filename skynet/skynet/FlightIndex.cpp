@@ -0,0 +1,111 @@
+#include "FlightIndex.h"
+#include <algorithm>
+
+void FlightIndex::insert(Handle handle, const Flight& flight) {
+    const Entry entry(TimeUtil::parseMinutes(flight.departureTime), handle);
+    byAircraft[flight.aircraftId].insert(entry);
+    forEachAirport(flight, [&](const std::string& code) { byAirport[code].insert(entry); });
+    byDeparture.insert(entry);
+}
+
+void FlightIndex::erase(Handle handle, const Flight& flight) {
+    const Entry entry(TimeUtil::parseMinutes(flight.departureTime), handle);
+
+    auto aircraftIt = byAircraft.find(flight.aircraftId);
+    if (aircraftIt != byAircraft.end()) {
+        aircraftIt->second.erase(entry);
+        if (aircraftIt->second.empty()) byAircraft.erase(aircraftIt);
+    }
+    forEachAirport(flight, [&](const std::string& code) {
+        auto airportIt = byAirport.find(code);
+        if (airportIt != byAirport.end()) {
+            airportIt->second.erase(entry);
+            if (airportIt->second.empty()) byAirport.erase(airportIt);
+        }
+    });
+    byDeparture.erase(entry);
+}
+
+void FlightIndex::rebuild(const EntityTable<Flight>& flights) {
+    clear();
+
+    // Gather every set's entries first, then build each set from its
+    // sorted run: linear, instead of one O(log n) insert per entry
+    std::vector<Entry> all;
+    all.reserve(flights.size());
+    std::unordered_map<std::string, std::vector<Entry>> aircraftRuns;
+    std::unordered_map<std::string, std::vector<Entry>> airportRuns;
+    for (auto it = flights.begin(); it != flights.end(); ++it) {
+        const Flight& flight = it->second;
+        const Entry entry(TimeUtil::parseMinutes(flight.departureTime), it.handle());
+        aircraftRuns[flight.aircraftId].push_back(entry);
+        forEachAirport(flight, [&](const std::string& code) { airportRuns[code].push_back(entry); });
+        all.push_back(entry);
+    }
+
+    auto build = [](std::vector<Entry>& run) {
+        std::sort(run.begin(), run.end());
+        return TimeOrder(run.begin(), run.end());
+    };
+    byDeparture = build(all);
+    for (auto& [id, run] : aircraftRuns) {
+        byAircraft.emplace(id, build(run));
+    }
+    for (auto& [code, run] : airportRuns) {
+        byAirport.emplace(code, build(run));
+    }
+}
+
+void FlightIndex::clear() {
+    byAircraft.clear();
+    byAirport.clear();
+    byDeparture.clear();
+}
+
+std::vector<FlightIndex::Handle> FlightIndex::findByAircraft(const std::string& aircraftId,
+                                                             int64_t from, int64_t to) const {
+    std::vector<Handle> result;
+    auto it = byAircraft.find(aircraftId);
+    if (it != byAircraft.end()) {
+        collect(it->second, from, to, result);
+    }
+    return result;
+}
+
+std::vector<FlightIndex::Handle> FlightIndex::findByAirport(const std::string& code,
+                                                            int64_t from, int64_t to) const {
+    std::vector<Handle> result;
+    auto it = byAirport.find(code);
+    if (it != byAirport.end()) {
+        collect(it->second, from, to, result);
+    }
+    return result;
+}
+
+std::vector<FlightIndex::Handle> FlightIndex::findByDeparture(int64_t from, int64_t to) const {
+    std::vector<Handle> result;
+    collect(byDeparture, from, to, result);
+    return result;
+}
+
+size_t FlightIndex::countByAircraft(const std::string& aircraftId) const {
+    auto it = byAircraft.find(aircraftId);
+    return it != byAircraft.end() ? it->second.size() : 0;
+}
+
+size_t FlightIndex::countByAirport(const std::string& code) const {
+    auto it = byAirport.find(code);
+    return it != byAirport.end() ? it->second.size() : 0;
+}
+
+void FlightIndex::collect(const TimeOrder& entries, int64_t from, int64_t to,
+                          std::vector<Handle>& out) {
+    if (from >= to) {
+        return;
+    }
+    auto first = entries.lower_bound(Entry(from, 0));
+    auto last = entries.lower_bound(Entry(to, 0));
+    for (auto it = first; it != last; ++it) {
+        out.push_back(it->second);
+    }
+}
@@ -0,0 +1,83 @@
+#ifndef FLIGHTINDEX_H
+#define FLIGHTINDEX_H
+#include "EntityTable.h"
+#include "Flight.h"
+#include "TimeUtil.h"
+#include <algorithm>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Secondary indexes over the flight table, ordered by departure
+ *
+ * Why?
+ * - "Flights of aircraft X", "flights touching LHR between 10:00 and
+ *   14:00" and "everything departing this afternoon" were linear scans
+ *   over every flight
+ * - Here each question is a range in an ordered set: O(log n + k) for
+ *   k results
+ *
+ * Indexes (all keyed by parsed departure time, then handle):
+ * - per aircraft id
+ * - per airport, for every airport on the route (origin, stops,
+ *   destination; listed once even if the route revisits it)
+ * - one over all flights
+ *
+ * Entries are flight handles (EntityTable<Flight>::Handle), not copies.
+ * The owner (DataStore) calls insert() and erase() with the flight as
+ * stored, so the departure time used for an entry is the one it was
+ * inserted with. Flights whose departure time does not parse are kept
+ * under TimeUtil::NO_TIME, before all others.
+ */
+class FlightIndex {
+public:
+    using Handle = EntityTable<Flight>::Handle;
+
+    void insert(Handle handle, const Flight& flight);
+    void erase(Handle handle, const Flight& flight);
+    void rebuild(const EntityTable<Flight>& flights);
+    void clear();
+
+    /**
+     * Handles of the flights departing in [from, to), by departure time
+     * (the default bounds include flights without a valid time)
+     */
+    std::vector<Handle> findByAircraft(const std::string& aircraftId,
+                                       int64_t from = TimeUtil::NO_TIME,
+                                       int64_t to = TimeUtil::MAX_TIME) const;
+    std::vector<Handle> findByAirport(const std::string& code,
+                                      int64_t from = TimeUtil::NO_TIME,
+                                      int64_t to = TimeUtil::MAX_TIME) const;
+    std::vector<Handle> findByDeparture(int64_t from, int64_t to) const;
+
+    size_t countByAircraft(const std::string& aircraftId) const;
+    size_t countByAirport(const std::string& code) const;
+
+private:
+    using Entry = std::pair<int64_t, Handle>;   // Departure minutes, flight
+    using TimeOrder = std::set<Entry>;
+
+    // Visit the airports on the route, each once
+    template <typename Visit>
+    static void forEachAirport(const Flight& flight, Visit&& visit) {
+        for (size_t i = 0; i < flight.route.size(); ++i) {
+            const std::string& code = flight.route[i];
+            if (std::find(flight.route.begin(), flight.route.begin() + i, code) ==
+                flight.route.begin() + i) {
+                visit(code);
+            }
+        }
+    }
+    static void collect(const TimeOrder& entries, int64_t from, int64_t to,
+                        std::vector<Handle>& out);
+
+    std::unordered_map<std::string, TimeOrder> byAircraft;
+    std::unordered_map<std::string, TimeOrder> byAirport;
+    TimeOrder byDeparture;
+};
+
+#endif // FLIGHTINDEX_H
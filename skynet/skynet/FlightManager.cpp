@@ -1,8 +1,11 @@
 #include "FlightManager.h"
 #include "DataStore.h"
 #include "Dijkstra.h"
+#include "FleetAssignment.h"
 #include "aircraft.h"
 #include "MapWidget.h"
+#include "Scheduling.h"
+#include "TimeUtil.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QFormLayout>
@@ -11,11 +14,12 @@
 #include <QMessageBox>
 #include <QHeaderView>
 #include <QLabel>
-#include <QProgressDialog>
 #include <QDateTime>
+#include <algorithm>
 
 FlightManager::FlightManager(QWidget *parent)
-    : QWidget(parent), mapWidget(nullptr), hasPlannedRoute(false) {
+    : QWidget(parent), mapWidget(nullptr), flightPageOffset(0), hasPlannedRoute(false),
+    routeExecutor(2), routeRequestId(0) {
     setupUi();
 }
 
@@ -47,7 +51,8 @@ void FlightManager::setupUi() {
     destCombo->addItem("-- Select Destination Airport --", "");
     aircraftCombo->addItem("-- Select Aircraft --", "");
 
-    for (const auto& airport : store.getAllAirports()) {
+    for (const Airport* record : store.getAirportTable().valuesByKey()) {
+        const Airport& airport = *record;
         QString display = QString("[%1] %2, %3")
         .arg(QString::fromStdString(airport.code))
             .arg(QString::fromStdString(airport.name))
@@ -58,7 +63,8 @@ void FlightManager::setupUi() {
         destCombo->addItem(display, code);
     }
 
-    for (const auto& ac : store.getAllAircraft()) {
+    for (const Aircraft* record : store.getAircraftTable().valuesByKey()) {
+        const Aircraft& ac = *record;
         if (ac.isAvailable()) {
             QString display = QString("[%1] %2 - %3 pax, %4 km/h")
             .arg(QString::fromStdString(ac.id))
@@ -81,16 +87,19 @@ void FlightManager::setupUi() {
 
     QPushButton* previewBtn = new QPushButton("🔍 Preview Route");
     QPushButton* planBtn = new QPushButton("📊 Calculate Optimal Path");
+    QPushButton* suggestBtn = new QPushButton("⛽ Suggest Aircraft");
     QPushButton* bookBtn = new QPushButton("✅ Book Flight");
     QPushButton* clearBtn = new QPushButton("🗑️ Clear");
 
     previewBtn->setStyleSheet("QPushButton { background-color: #2196F3; color: white; padding: 8px; }");
     planBtn->setStyleSheet("QPushButton { background-color: #4CAF50; color: white; padding: 8px; }");
+    suggestBtn->setStyleSheet("QPushButton { background-color: #607D8B; color: white; padding: 8px; }");
     bookBtn->setStyleSheet("QPushButton { background-color: #FF9800; color: white; padding: 8px; }");
     clearBtn->setStyleSheet("QPushButton { padding: 8px; }");
 
     btnLayout->addWidget(previewBtn);
     btnLayout->addWidget(planBtn);
+    btnLayout->addWidget(suggestBtn);
     btnLayout->addWidget(bookBtn);
     btnLayout->addWidget(clearBtn);
 
@@ -134,14 +143,35 @@ void FlightManager::setupUi() {
     flightTable->setSelectionBehavior(QAbstractItemView::SelectRows);
     flightTable->setAlternatingRowColors(true);
 
+    QHBoxLayout* filterLayout = new QHBoxLayout();
+    statusFilter = new QComboBox();
+    statusFilter->addItem("All statuses", "");
+    statusFilter->addItem("SCHEDULED", "SCHEDULED");
+    statusFilter->addItem("COMPLETED", "COMPLETED");
+    airportFilter = new QComboBox();
+    loadFilterAirports();
+
+    filterLayout->addWidget(new QLabel("Status:"));
+    filterLayout->addWidget(statusFilter);
+    filterLayout->addWidget(new QLabel("Airport:"));
+    filterLayout->addWidget(airportFilter);
+    filterLayout->addStretch();
+
     QHBoxLayout* tableButtons = new QHBoxLayout();
     QPushButton* refreshBtn = new QPushButton("🔄 Refresh");
     QPushButton* deleteBtn = new QPushButton("❌ Delete Selected");
+    previousPageBtn = new QPushButton("◀ Previous");
+    nextPageBtn = new QPushButton("Next ▶");
+    pageLabel = new QLabel();
 
     tableButtons->addWidget(refreshBtn);
     tableButtons->addWidget(deleteBtn);
     tableButtons->addStretch();
+    tableButtons->addWidget(previousPageBtn);
+    tableButtons->addWidget(pageLabel);
+    tableButtons->addWidget(nextPageBtn);
 
+    flightsLayout->addLayout(filterLayout);
     flightsLayout->addWidget(flightTable);
     flightsLayout->addLayout(tableButtons);
 
@@ -152,10 +182,17 @@ void FlightManager::setupUi() {
     // ==================== CONNECTIONS ====================
     connect(previewBtn, &QPushButton::clicked, this, &FlightManager::onPreviewRoute);
     connect(planBtn, &QPushButton::clicked, this, &FlightManager::onPlanFlight);
+    connect(suggestBtn, &QPushButton::clicked, this, &FlightManager::onSuggestAircraft);
     connect(bookBtn, &QPushButton::clicked, this, &FlightManager::onBookFlight);
     connect(clearBtn, &QPushButton::clicked, this, &FlightManager::onClearSelection);
     connect(refreshBtn, &QPushButton::clicked, this, &FlightManager::onRefreshFlights);
     connect(deleteBtn, &QPushButton::clicked, this, &FlightManager::onDeleteFlight);
+    connect(previousPageBtn, &QPushButton::clicked, this, &FlightManager::onPreviousFlightPage);
+    connect(nextPageBtn, &QPushButton::clicked, this, &FlightManager::onNextFlightPage);
+    connect(statusFilter, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &FlightManager::onFlightFilterChanged);
+    connect(airportFilter, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &FlightManager::onFlightFilterChanged);
 
     // Initial load
     onRefreshFlights();
@@ -204,20 +241,29 @@ void FlightManager::onPreviewRoute() {
     QString origin = originCombo->currentData().toString();
     QString dest = destCombo->currentData().toString();
 
-    QProgressDialog progress("Calculating optimal route...", nullptr, 0, 100, this);
-    progress.setWindowModality(Qt::WindowModal);
-    progress.setValue(30);
+    // One snapshot for both, so graph and hierarchy are the same version
+    auto snapshot = DataStore::getInstance().getGraphSnapshot();
 
-    DataStore& store = DataStore::getInstance();
-    Graph& graph = store.getGraph();
+    // Contraction Hierarchies: preprocessed once per version in the
+    // background; until then the worker answers with a bidirectional search
+    QueryExecutor::Network network{snapshot->getCompactGraph(), nullptr, snapshot};
+    QueryExecutor::Query query(origin.toStdString(), dest.toStdString());
 
-    progress.setValue(60);
+    quint64 requestId = ++routeRequestId;
+    hasPlannedRoute = false;
+    resultText->setPlainText("⏳ Calculating optimal route...");
 
-    PathResult result = Dijkstra::findShortestPath(graph,
-                                                   origin.toStdString(),
-                                                   dest.toStdString());
+    routeExecutor.submit(network, query, [this, requestId](const PathResult& result) {
+        // Runs on a worker thread: hand the result to the GUI thread
+        QMetaObject::invokeMethod(this, [this, requestId, result]() {
+            onRouteReady(requestId, result);
+        }, Qt::QueuedConnection);
+    });
+}
 
-    progress.setValue(100);
+void FlightManager::onRouteReady(quint64 requestId, const PathResult& result) {
+    // A newer preview was requested while this one was running
+    if (requestId != routeRequestId) return;
 
     if (result.found) {
         showRoutePreview(result);
@@ -270,6 +316,7 @@ void FlightManager::showRoutePreview(const PathResult& result) {
     output += "📊 ROUTE STATISTICS:\n";
     output += QString("   • Total Distance: %1 km\n").arg(result.totalDistance, 0, 'f', 2);
     output += QString("   • Number of Stops: %1\n").arg(result.path.size() - 2);
+    output += QString("   • Airports Searched: %1\n").arg(result.nodesExpanded);
 
     // Calculate with selected aircraft
     QString aircraftId = aircraftCombo->currentData().toString();
@@ -305,6 +352,40 @@ void FlightManager::onPlanFlight() {
     onPreviewRoute();
 }
 
+void FlightManager::onSuggestAircraft() {
+    if (!hasPlannedRoute) {
+        QMessageBox::warning(this, "⚠️ No Route Planned",
+                             "Please preview the route first, then ask for an aircraft.");
+        return;
+    }
+
+    // Same departure the booking will use (2 hours from now)
+    Flight flight;
+    flight.route = currentPath.path;
+    flight.totalDistance = currentPath.totalDistance;
+    flight.departureTime = QDateTime::currentDateTime().addSecs(2 * 3600)
+                               .toString("yyyy-MM-ddTHH:mm:ss").toStdString();
+
+    // Cheapest available aircraft that is free and positioned at the origin
+    FleetAssignment::Result result = FleetAssignment::assign({flight}, DataStore::getInstance());
+    const FleetAssignment::Assignment& best = result.assignments[0];
+    if (best.aircraftId.empty()) {
+        QMessageBox::warning(this, "❌ No Aircraft Free",
+                             "No available aircraft is free for this route at that time\n"
+                             "and positioned at the origin airport.");
+        return;
+    }
+
+    int index = aircraftCombo->findData(QString::fromStdString(best.aircraftId));
+    if (index >= 0) {
+        aircraftCombo->setCurrentIndex(index);
+    }
+    resultText->append(QString("\n⛽ SUGGESTED AIRCRAFT: %1 (fuel %2 L, %3 hrs)")
+                           .arg(QString::fromStdString(best.aircraftId))
+                           .arg(best.fuelCost, 0, 'f', 0)
+                           .arg(best.estimatedTime, 0, 'f', 2));
+}
+
 void FlightManager::onBookFlight() {
     if (!validateInputs()) return;
 
@@ -319,7 +400,7 @@ void FlightManager::onBookFlight() {
                                        "Are you sure you want to book this flight?\n\n"
                                        "This will:\n"
                                        "• Create a flight reservation\n"
-                                       "• Update aircraft status\n"
+                                       "• Check the aircraft's schedule\n"
                                        "• Save to flights database\n\n"
                                        "Proceed with booking?",
                                        QMessageBox::Yes | QMessageBox::No);
@@ -336,7 +417,7 @@ void FlightManager::onBookFlight() {
     if (!aircraft || !aircraft->isAvailable()) {
         QMessageBox::critical(this, "❌ Aircraft Unavailable",
                               "The selected aircraft is no longer available.\n"
-                              "It may have been booked by another flight.\n\n"
+                              "It may be in maintenance or retired.\n\n"
                               "Please select a different aircraft.");
         return;
     }
@@ -359,14 +440,35 @@ void FlightManager::onBookFlight() {
     flight.departureTime = departure.toString("yyyy-MM-ddTHH:mm:ss").toStdString();
     flight.status = "SCHEDULED";
 
+    // The aircraft must be free from departure until arrival plus
+    // turnaround; the store's live schedule answers without a full scan
+    std::vector<const Flight*> conflicts = store.findScheduleConflicts(flight);
+    if (!conflicts.empty()) {
+        QString details;
+        for (const Flight* existing : conflicts) {
+            int64_t start, end;
+            Scheduling::getTimeWindow(*existing, start, end);
+            details += QString("• %1: %2 → %3, %4 to %5\n")
+                           .arg(QString::fromStdString(existing->flightNumber))
+                           .arg(QString::fromStdString(existing->getOrigin()))
+                           .arg(QString::fromStdString(existing->getDestination()))
+                           .arg(QString::fromStdString(TimeUtil::formatMinutes(start)))
+                           .arg(QString::fromStdString(TimeUtil::formatMinutes(end)));
+        }
+        QMessageBox::warning(this, "❌ Schedule Conflict",
+                             QString("Aircraft %1 is already booked at that time "
+                                     "(including %2 min turnaround):\n\n%3\n"
+                                     "Please select a different aircraft.")
+                                 .arg(aircraftId)
+                                 .arg(Scheduling::TURNAROUND_MINUTES)
+                                 .arg(details));
+        return;
+    }
+
     // Save flight
     if (store.addFlight(flight)) {
-        // Update aircraft status
-        aircraft->status = AircraftStatus::IN_FLIGHT;
-        store.updateAircraft(*aircraft);
-
-        // Save all data
-        store.saveAll();
+        // Make the booking durable (journal append, not a full rewrite)
+        store.syncJournal();
 
         // Success message
         QString message = QString(
@@ -404,13 +506,30 @@ void FlightManager::onBookFlight() {
 void FlightManager::onRefreshFlights() {
     flightTable->setRowCount(0);
 
+    FlightFilter filter;
+    filter.status = statusFilter->currentData().toString().toStdString();
+    filter.airport = airportFilter->currentData().toString().toStdString();
+
+    // Copy only the visible page; step back if deletions emptied it
     DataStore& store = DataStore::getInstance();
-    auto flights = store.getAllFlights();
+    Page<Flight> page = store.getFlightPage(flightPageOffset, FLIGHTS_PER_PAGE, filter);
+    if (page.items.empty() && page.total > 0) {
+        flightPageOffset = (page.total - 1) / FLIGHTS_PER_PAGE * FLIGHTS_PER_PAGE;
+        page = store.getFlightPage(flightPageOffset, FLIGHTS_PER_PAGE, filter);
+    }
+
+    size_t pageCount = std::max<size_t>(1, (page.total + FLIGHTS_PER_PAGE - 1) / FLIGHTS_PER_PAGE);
+    pageLabel->setText(QString("Page %1 of %2 (%3 flights)")
+                           .arg(flightPageOffset / FLIGHTS_PER_PAGE + 1)
+                           .arg(pageCount)
+                           .arg(page.total));
+    previousPageBtn->setEnabled(flightPageOffset > 0);
+    nextPageBtn->setEnabled(flightPageOffset + FLIGHTS_PER_PAGE < page.total);
 
-    for (const auto& flight : flights) {
-        int row = flightTable->rowCount();
-        flightTable->insertRow(row);
+    flightTable->setRowCount(static_cast<int>(page.items.size()));
 
+    int row = 0;
+    for (const auto& flight : page.items) {
         flightTable->setItem(row, 0,
                              new QTableWidgetItem(QString::fromStdString(flight.flightNumber)));
 
@@ -450,11 +569,41 @@ void FlightManager::onRefreshFlights() {
             statusItem->setBackground(QColor(33, 150, 243, 50)); // Blue
         }
         flightTable->setItem(row, 7, statusItem);
+        ++row;
     }
 
     flightTable->resizeColumnsToContents();
 }
 
+void FlightManager::loadFilterAirports() {
+    QString current = airportFilter->currentData().toString();
+
+    airportFilter->blockSignals(true);
+    airportFilter->clear();
+    airportFilter->addItem("All airports", "");
+    for (const Airport* airport : DataStore::getInstance().getAirportTable().valuesByKey()) {
+        QString code = QString::fromStdString(airport->code);
+        airportFilter->addItem(code, code);
+    }
+    airportFilter->setCurrentIndex(std::max(0, airportFilter->findData(current)));
+    airportFilter->blockSignals(false);
+}
+
+void FlightManager::onFlightFilterChanged() {
+    flightPageOffset = 0;
+    onRefreshFlights();
+}
+
+void FlightManager::onPreviousFlightPage() {
+    flightPageOffset -= std::min<size_t>(flightPageOffset, FLIGHTS_PER_PAGE);
+    onRefreshFlights();
+}
+
+void FlightManager::onNextFlightPage() {
+    flightPageOffset += FLIGHTS_PER_PAGE;
+    onRefreshFlights();
+}
+
 void FlightManager::onClearSelection() {
     originCombo->setCurrentIndex(0);
     destCombo->setCurrentIndex(0);
@@ -485,12 +634,13 @@ void FlightManager::onDeleteFlight() {
     if (reply == QMessageBox::Yes) {
         DataStore& store = DataStore::getInstance();
         if (store.deleteFlight(flightNum.toStdString())) {
-            store.saveAll();
+            store.syncJournal();
             QMessageBox::information(this, "Success", "Flight deleted.");
             onRefreshFlights();
         }
     }
 }
 void FlightManager::refreshData() {
+    loadFilterAirports();
     onRefreshFlights();
 }
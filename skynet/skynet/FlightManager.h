@@ -5,7 +5,10 @@
 #include <QComboBox>
 #include <QTextEdit>
 #include <QTableWidget>
+#include <QPushButton>
+#include <QLabel>
 #include "PathResult.h"
+#include "QueryExecutor.h"
 
 class MapWidget;
 
@@ -19,15 +22,21 @@ public:
 private slots:
     void onPlanFlight();
     void onBookFlight();
+    void onSuggestAircraft();
     void onRefreshFlights();
     void onPreviewRoute();
     void onClearSelection();
     void onDeleteFlight();
+    void onFlightFilterChanged();
+    void onPreviousFlightPage();
+    void onNextFlightPage();
 
 private:
     void setupUi();
     void showRoutePreview(const PathResult& result);
+    void onRouteReady(quint64 requestId, const PathResult& result);
     bool validateInputs();
+    void loadFilterAirports();
 
     QComboBox* originCombo;
     QComboBox* destCombo;
@@ -36,8 +45,22 @@ private:
     QTableWidget* flightTable;
     MapWidget* mapWidget;
 
+    // The booked-flights table shows one page of the (filtered) flights
+    static constexpr int FLIGHTS_PER_PAGE = 200;
+    QComboBox* statusFilter;
+    QComboBox* airportFilter;
+    QPushButton* previousPageBtn;
+    QPushButton* nextPageBtn;
+    QLabel* pageLabel;
+    size_t flightPageOffset;
+
     PathResult currentPath;
     bool hasPlannedRoute;
+
+    // Route searches run on worker threads; results are posted back here.
+    // Only the latest request is shown, so stale answers are dropped.
+    QueryExecutor routeExecutor;
+    quint64 routeRequestId;
 };
 
 #endif // FLIGHTMANAGER_H
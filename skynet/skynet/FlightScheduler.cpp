@@ -0,0 +1,89 @@
+#include "FlightScheduler.h"
+#include "Scheduling.h"
+#include <algorithm>
+
+namespace {
+
+bool isScheduled(const Flight& flight) {
+    return flight.status == "SCHEDULED";
+}
+
+} // namespace
+
+void FlightScheduler::add(Handle handle, const Flight& flight) {
+    int64_t start, end;
+    if (!isScheduled(flight) || !Scheduling::getTimeWindow(flight, start, end)) {
+        return;
+    }
+
+    Occupancy& occupancy = byAircraft[flight.aircraftId];
+    if (occupancy.windows.emplace(std::make_pair(start, handle), end).second) {
+        occupancy.longestWindow = std::max(occupancy.longestWindow, end - start);
+        ++scheduledCount;
+    }
+}
+
+void FlightScheduler::remove(Handle handle, const Flight& flight) {
+    int64_t start, end;
+    if (!isScheduled(flight) || !Scheduling::getTimeWindow(flight, start, end)) {
+        return;
+    }
+
+    auto it = byAircraft.find(flight.aircraftId);
+    if (it != byAircraft.end() && it->second.windows.erase(std::make_pair(start, handle)) > 0) {
+        --scheduledCount;
+        if (it->second.windows.empty()) byAircraft.erase(it);
+    }
+}
+
+void FlightScheduler::rebuild(const EntityTable<Flight>& flights) {
+    clear();
+
+    // As in FlightIndex::rebuild(): sort each aircraft's run, then build
+    // its map from the sorted range in linear time
+    using Window = std::pair<std::pair<int64_t, Handle>, int64_t>;
+    std::unordered_map<std::string, std::vector<Window>> runs;
+    for (auto it = flights.begin(); it != flights.end(); ++it) {
+        int64_t start, end;
+        if (isScheduled(it->second) && Scheduling::getTimeWindow(it->second, start, end)) {
+            runs[it->second.aircraftId].push_back({{start, it.handle()}, end});
+        }
+    }
+
+    for (auto& [aircraftId, run] : runs) {
+        std::sort(run.begin(), run.end());
+        Occupancy& occupancy = byAircraft[aircraftId];
+        occupancy.windows = std::map<std::pair<int64_t, Handle>, int64_t>(run.begin(), run.end());
+        for (const Window& window : run) {
+            occupancy.longestWindow = std::max(occupancy.longestWindow,
+                                               window.second - window.first.first);
+        }
+        scheduledCount += run.size();
+    }
+}
+
+void FlightScheduler::clear() {
+    byAircraft.clear();
+    scheduledCount = 0;
+}
+
+std::vector<FlightScheduler::Handle> FlightScheduler::findOverlaps(const std::string& aircraftId,
+                                                                   int64_t start,
+                                                                   int64_t end) const {
+    std::vector<Handle> result;
+    auto it = byAircraft.find(aircraftId);
+    if (it == byAircraft.end() || start >= end) {
+        return result;
+    }
+
+    // Windows starting at or before start - longestWindow end by start
+    const Occupancy& occupancy = it->second;
+    auto window = occupancy.windows.lower_bound(
+        std::make_pair(start - occupancy.longestWindow + 1, Handle(0)));
+    for (; window != occupancy.windows.end() && window->first.first < end; ++window) {
+        if (window->second > start) {
+            result.push_back(window->first.second);
+        }
+    }
+    return result;
+}
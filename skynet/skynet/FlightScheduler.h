@@ -0,0 +1,59 @@
+#ifndef FLIGHTSCHEDULER_H
+#define FLIGHTSCHEDULER_H
+#include "EntityTable.h"
+#include "Flight.h"
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Live per-aircraft occupancy of the scheduled flights
+ *
+ * Why keep it live?
+ * - A booking check used to rescan every flight. Here each aircraft's
+ *   SCHEDULED flights sit in an ordered map of time windows
+ *   (Scheduling::getTimeWindow: departure to arrival plus turnaround).
+ *   DataStore updates it on addFlight() and deleteFlight(), so a check
+ *   costs O(log n + k) however large the schedule grows
+ *
+ * Why track the longest window?
+ * - Windows are ordered by start. Anything overlapping [start, end)
+ *   must start after start - longestWindow, so the search begins there
+ *   and stops at end. In a schedule without overlaps only a handful of
+ *   windows fall in that band.
+ *
+ * The model has no gates or stands, so aircraft are the only resource
+ * tracked. Entries are flight handles (EntityTable<Flight>::Handle).
+ */
+class FlightScheduler {
+public:
+    using Handle = EntityTable<Flight>::Handle;
+
+    void add(Handle handle, const Flight& flight);
+    void remove(Handle handle, const Flight& flight);
+    void rebuild(const EntityTable<Flight>& flights);
+    void clear();
+
+    /**
+     * Scheduled flights on the aircraft whose windows overlap
+     * [start, end), ordered by start
+     */
+    std::vector<Handle> findOverlaps(const std::string& aircraftId,
+                                     int64_t start, int64_t end) const;
+
+    size_t getScheduledCount() const { return scheduledCount; }
+
+private:
+    struct Occupancy {
+        std::map<std::pair<int64_t, Handle>, int64_t> windows;   // (start, flight) -> end
+        int64_t longestWindow = 0;   // Never shrinks, so it stays an upper bound
+    };
+
+    std::unordered_map<std::string, Occupancy> byAircraft;
+    size_t scheduledCount = 0;
+};
+
+#endif // FLIGHTSCHEDULER_H
@@ -1,7 +1,16 @@
 #include "Graph.h"
 #include <algorithm>
 
-Graph::Graph() {}
+Graph::Graph() : edgeCount(0) {}
+
+std::string Graph::edgeKey(const std::string& from, const std::string& to) {
+    // IATA codes never contain '\0'; short keys stay in the SSO buffer
+    std::string key;
+    key.reserve(from.size() + 1 + to.size());
+    key.append(from).push_back('\0');
+    key.append(to);
+    return key;
+}
 
 void Graph::addNode(const std::string& nodeId) {
     if (!hasNode(nodeId)) {
@@ -13,18 +22,21 @@ void Graph::addNode(const std::string& nodeId) {
 void Graph::removeNode(const std::string& nodeId) {
     if (!hasNode(nodeId)) return;
 
-    // Remove all edges pointing to this node
-    for (auto& pair : adjacencyList) {
-        auto& edges = pair.second;
-        edges.erase(
-            std::remove_if(edges.begin(), edges.end(),
-                           [&nodeId](const Edge& e) { return e.destination == nodeId; }),
-            edges.end()
-            );
+    // Remove all edges pointing to this node (only if there are any)
+    if (getInDegree(nodeId) > 0) {
+        for (const auto& source : nodes) {
+            if (source != nodeId) removeEdge(source, nodeId);
+        }
     }
 
     // Remove node's own adjacency list
+    for (const Edge& edge : adjacencyList[nodeId]) {
+        edgeIndex.erase(edgeKey(nodeId, edge.destination));
+        --inDegree[edge.destination];
+        --edgeCount;
+    }
     adjacencyList.erase(nodeId);
+    inDegree.erase(nodeId);
     nodes.erase(nodeId);
 }
 
@@ -32,7 +44,7 @@ bool Graph::hasNode(const std::string& nodeId) const {
     return nodes.find(nodeId) != nodes.end();
 }
 
-std::set<std::string> Graph::getNodes() const {
+const std::set<std::string>& Graph::getNodes() const {
     return nodes;
 }
 
@@ -42,37 +54,48 @@ void Graph::addEdge(const std::string& from, const std::string& to,
     addNode(from);
     addNode(to);
 
-    // Check if edge already exists, update if so
     auto& edges = adjacencyList[from];
-    for (auto& edge : edges) {
-        if (edge.destination == to) {
-            edge.weight = weight;
-            edge.cost = cost;
-            return;
-        }
+    auto inserted = edgeIndex.emplace(edgeKey(from, to), edges.size());
+
+    // Edge already exists: update in place
+    if (!inserted.second) {
+        Edge& edge = edges[inserted.first->second];
+        edge.weight = weight;
+        edge.cost = cost;
+        return;
     }
 
     // Add new edge
     edges.emplace_back(to, weight, cost);
+    ++inDegree[to];
+    ++edgeCount;
 }
 
 void Graph::removeEdge(const std::string& from, const std::string& to) {
-    if (!hasNode(from)) return;
+    auto found = edgeIndex.find(edgeKey(from, to));
+    if (found == edgeIndex.end()) return;
 
+    // Move the last edge into the hole and re-point its index entry
     auto& edges = adjacencyList[from];
-    edges.erase(
-        std::remove_if(edges.begin(), edges.end(),
-                       [&to](const Edge& e) { return e.destination == to; }),
-        edges.end()
-        );
+    size_t slot = found->second;
+    edgeIndex.erase(found);
+    if (slot + 1 != edges.size()) {
+        edges[slot] = std::move(edges.back());
+        edgeIndex[edgeKey(from, edges[slot].destination)] = slot;
+    }
+    edges.pop_back();
+
+    --inDegree[to];
+    --edgeCount;
 }
 
 bool Graph::hasEdge(const std::string& from, const std::string& to) const {
-    if (!hasNode(from)) return false;
+    return edgeIndex.find(edgeKey(from, to)) != edgeIndex.end();
+}
 
-    const auto& edges = adjacencyList.at(from);
-    return std::any_of(edges.begin(), edges.end(),
-                       [&to](const Edge& e) { return e.destination == to; });
+int Graph::getInDegree(const std::string& nodeId) const {
+    auto it = inDegree.find(nodeId);
+    return it != inDegree.end() ? it->second : 0;
 }
 
 std::vector<Edge> Graph::getNeighbors(const std::string& nodeId) const {
@@ -80,21 +103,28 @@ std::vector<Edge> Graph::getNeighbors(const std::string& nodeId) const {
     return adjacencyList.at(nodeId);
 }
 
+EdgeRange Graph::neighbors(const std::string& nodeId) const {
+    auto it = adjacencyList.find(nodeId);
+    if (it == adjacencyList.end() || it->second.empty()) return {};
+
+    const Edge* first = it->second.data();
+    return EdgeRange(first, first + it->second.size());
+}
+
 int Graph::getNodeCount() const {
     return nodes.size();
 }
 
 int Graph::getEdgeCount() const {
-    int count = 0;
-    for (const auto& pair : adjacencyList) {
-        count += pair.second.size();
-    }
-    return count;
+    return edgeCount;
 }
 
 void Graph::clear() {
     adjacencyList.clear();
     nodes.clear();
+    edgeIndex.clear();
+    inDegree.clear();
+    edgeCount = 0;
 }
 
 bool Graph::isEmpty() const {
@@ -4,6 +4,7 @@
 #include <vector>
 #include <map>
 #include <set>
+#include <unordered_map>
 
 /**
  * @brief Weighted directed graph using adjacency list
@@ -16,6 +17,15 @@
  * Structure: map<string, vector<Edge>>
  * - Key: airport code (node)
  * - Value: list of outgoing edges with weights
+ *
+ * Why an edge index?
+ * - addEdge/hasEdge/removeEdge used to scan the source's edge list, so
+ *   loading routes into a hub airport was quadratic in its degree
+ * - edgeIndex maps (from, to) to the edge's slot in its list: all three
+ *   are O(1) expected; removal swaps the last edge into the hole, so
+ *   the order of a node's edges is not preserved
+ * - Per-node in-degree lets removeNode skip the scan for incoming edges
+ *   when there are none
  */
 
 struct Edge {
@@ -27,6 +37,32 @@ struct Edge {
         : destination(dest), weight(w), cost(c) {}
 };
 
+/**
+ * @brief Non-owning view over a node's stored adjacency list
+ *
+ * Why a view instead of std::vector<Edge>?
+ * - Returning the vector by value copies every Edge, including one
+ *   std::string allocation per edge, on every node expansion
+ * - A pointer pair lets callers iterate the stored edges in place
+ *
+ * The view is invalidated by any modification of the Graph.
+ */
+class EdgeRange {
+public:
+    EdgeRange() : first(nullptr), last(nullptr) {}
+    EdgeRange(const Edge* begin, const Edge* end) : first(begin), last(end) {}
+
+    const Edge* begin() const { return first; }
+    const Edge* end() const { return last; }
+    size_t size() const { return static_cast<size_t>(last - first); }
+    bool empty() const { return first == last; }
+    const Edge& operator[](size_t i) const { return first[i]; }
+
+private:
+    const Edge* first;
+    const Edge* last;
+};
+
 class Graph {
 public:
     Graph();
@@ -35,16 +71,18 @@ public:
     void addNode(const std::string& nodeId);
     void removeNode(const std::string& nodeId);
     bool hasNode(const std::string& nodeId) const;
-    std::set<std::string> getNodes() const;
+    const std::set<std::string>& getNodes() const;
 
     // Edge operations (directed)
     void addEdge(const std::string& from, const std::string& to,
                  double weight, double cost = 0.0);
     void removeEdge(const std::string& from, const std::string& to);
     bool hasEdge(const std::string& from, const std::string& to) const;
+    int getInDegree(const std::string& nodeId) const;
 
     // Query operations
     std::vector<Edge> getNeighbors(const std::string& nodeId) const;
+    EdgeRange neighbors(const std::string& nodeId) const;  // Zero-copy view
     int getNodeCount() const;
     int getEdgeCount() const;
 
@@ -58,6 +96,13 @@ private:
 
     // Quick lookup for node existence (could use adjacencyList.count() but this is clearer)
     std::set<std::string> nodes;
+
+    // (from, to) -> position in adjacencyList[from]
+    std::unordered_map<std::string, size_t> edgeIndex;
+    std::unordered_map<std::string, int> inDegree;
+    int edgeCount;
+
+    static std::string edgeKey(const std::string& from, const std::string& to);
 };
 
 #endif // GRAPH_H
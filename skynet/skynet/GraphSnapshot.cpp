@@ -0,0 +1,35 @@
+#include "GraphSnapshot.h"
+#include <iostream>
+
+GraphSnapshot::GraphSnapshot(uint64_t version, std::shared_ptr<const CompactGraph> compactGraph)
+    : version(version), compactGraph(std::move(compactGraph)) {}
+
+const Graph& GraphSnapshot::getGraph() const {
+    std::call_once(graphOnce, [this]() {
+        const CompactGraph& cg = *compactGraph;
+        for (CompactGraph::NodeId u = 0; u < cg.getNodeCount(); ++u) {
+            graph.addNode(cg.getNodeCode(u));
+        }
+        for (CompactGraph::NodeId u = 0; u < cg.getNodeCount(); ++u) {
+            for (uint32_t e = cg.edgeBegin(u); e < cg.edgeEnd(u); ++e) {
+                graph.addEdge(cg.getNodeCode(u), cg.getNodeCode(cg.edgeTarget(e)),
+                              cg.edgeWeight(e), cg.edgeCost(e));
+            }
+        }
+    });
+    return graph;
+}
+
+std::shared_ptr<const ContractionHierarchy> GraphSnapshot::getContractionHierarchy() const {
+    std::call_once(hierarchyOnce, [this]() {
+        auto built = std::make_shared<const ContractionHierarchy>(compactGraph);
+        std::cout << "✓ Contraction hierarchy built (graph v" << version << "): "
+                  << built->getShortcutCount() << " shortcuts" << std::endl;
+        std::atomic_store(&hierarchy, std::move(built));
+    });
+    return std::atomic_load(&hierarchy);
+}
+
+std::shared_ptr<const ContractionHierarchy> GraphSnapshot::tryGetContractionHierarchy() const {
+    return std::atomic_load(&hierarchy);
+}
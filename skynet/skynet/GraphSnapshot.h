@@ -0,0 +1,71 @@
+#ifndef GRAPHSNAPSHOT_H
+#define GRAPHSNAPSHOT_H
+#include "Graph.h"
+#include "CompactGraph.h"
+#include "ContractionHierarchy.h"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+/**
+ * @brief Immutable, versioned view of the flight network
+ *
+ * Why snapshots?
+ * - DataStore used to clear and refill one Graph in place, so a search
+ *   running on another thread could observe a half-built network
+ * - Writers now build a complete new snapshot off to the side and
+ *   publish it with a single atomic pointer swap (RCU-style)
+ * - Readers grab the current shared_ptr and keep using that version for
+ *   as long as they hold it; the last holder frees it
+ *
+ * Everything reachable from a snapshot is read-only. The CompactGraph is
+ * the primary form; the adjacency-list Graph and the contraction
+ * hierarchy are derived from it at most once per snapshot on first
+ * request (std::call_once makes concurrent first requests safe), so
+ * publishing costs one CSR build and nothing else.
+ *
+ * Preprocessing the hierarchy can take seconds on a large network.
+ * Callers that must not wait use tryGetContractionHierarchy() and fall
+ * back to a plain search until someone else has built it.
+ */
+class GraphSnapshot {
+public:
+    GraphSnapshot(uint64_t version, std::shared_ptr<const CompactGraph> compactGraph);
+
+    GraphSnapshot(const GraphSnapshot&) = delete;
+    GraphSnapshot& operator=(const GraphSnapshot&) = delete;
+
+    // Increases by one with every published rebuild
+    uint64_t getVersion() const { return version; }
+
+    const std::shared_ptr<const CompactGraph>& getCompactGraph() const { return compactGraph; }
+
+    /**
+     * Adjacency-list view of this version (built from the CSR on first use)
+     */
+    const Graph& getGraph() const;
+
+    /**
+     * Contraction hierarchy for this version (preprocessed on first use;
+     * blocks while another thread is building it)
+     */
+    std::shared_ptr<const ContractionHierarchy> getContractionHierarchy() const;
+
+    /**
+     * Contraction hierarchy if it has been built, nullptr otherwise
+     * (never blocks, never starts the build)
+     */
+    std::shared_ptr<const ContractionHierarchy> tryGetContractionHierarchy() const;
+
+private:
+    const uint64_t version;
+    const std::shared_ptr<const CompactGraph> compactGraph;
+
+    mutable std::once_flag graphOnce;
+    mutable Graph graph;
+
+    mutable std::once_flag hierarchyOnce;
+    mutable std::shared_ptr<const ContractionHierarchy> hierarchy;   // std::atomic_load/store only
+};
+
+#endif // GRAPHSNAPSHOT_H
@@ -0,0 +1,244 @@
+#include "Journal.h"
+#include "AtomicFileWriter.h"
+#include "FileUtil.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+bool readWholeFile(const std::string& path, std::string& contents) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+    std::ostringstream buffer;
+    buffer << in.rdbuf();
+    contents = buffer.str();
+    return true;
+}
+
+} // namespace
+
+Journal::Journal()
+    : file(nullptr), compactedSeq(0), writtenSeq(0), durableSeq(0), appendedSeq(0),
+    retrySeq(0), opened(false), writeFailed(false), stopping(false) {}
+
+Journal::~Journal() {
+    close();
+}
+
+bool Journal::open(const std::string& logPath) {
+    close();
+
+    // Cut off a torn last record so the next append starts on a fresh line
+    std::string contents;
+    std::deque<std::string> existing;
+    if (readWholeFile(logPath, contents)) {
+        size_t complete = contents.rfind('\n');
+        complete = (complete == std::string::npos) ? 0 : complete + 1;
+        if (complete < contents.size()) {
+            std::error_code ec;
+            std::filesystem::resize_file(logPath, complete, ec);
+            if (ec) return false;
+        }
+        replay(logPath, [&](std::string_view record) { existing.emplace_back(record); });
+    }
+
+    std::FILE* logFile = std::fopen(logPath.c_str(), "ab");
+    if (!logFile) {
+        return false;
+    }
+
+    // Records already on disk count as appended and durable
+    path = logPath;
+    file = logFile;
+    records.swap(existing);
+    compactedSeq = 0;
+    appendedSeq = writtenSeq = durableSeq = records.size();
+    retrySeq = 0;
+    opened = true;
+    writeFailed = false;
+    stopping = false;
+    flusher = std::thread(&Journal::flusherLoop, this);
+    return true;
+}
+
+void Journal::close() {
+    if (!flusher.joinable()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    recordsQueued.notify_one();
+    flusher.join();   // Writes whatever is still queued first
+
+    std::lock_guard<std::mutex> io(ioMutex);
+    std::lock_guard<std::mutex> lock(mutex);
+    if (file) {
+        std::fclose(file);
+        file = nullptr;
+    }
+    opened = false;
+    records.clear();
+    recordsDurable.notify_all();
+}
+
+bool Journal::isOpen() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return opened && !stopping;
+}
+
+void Journal::append(std::string record) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!opened || stopping) {
+            return;
+        }
+        records.push_back(std::move(record));
+        ++appendedSeq;
+    }
+    recordsQueued.notify_one();
+}
+
+bool Journal::sync() {
+    std::unique_lock<std::mutex> lock(mutex);
+    const uint64_t target = appendedSeq;
+    recordsDurable.wait(lock, [&]() { return durableSeq >= target || !file; });
+    return !writeFailed && durableSeq >= target;
+}
+
+uint64_t Journal::getLastSequence() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return appendedSeq;
+}
+
+bool Journal::compact(uint64_t throughSeq) {
+    // Both locks: no group is being written and none can start
+    std::lock_guard<std::mutex> io(ioMutex);
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!opened) {
+        return false;
+    }
+
+    throughSeq = std::min(throughSeq, appendedSeq);
+    if (throughSeq <= compactedSeq) {
+        return !writeFailed;
+    }
+
+    // Compacted records are in the base files, written or not
+    records.erase(records.begin(), records.begin() + (throughSeq - compactedSeq));
+    compactedSeq = throughSeq;
+    writtenSeq = std::max(writtenSeq, throughSeq);
+    durableSeq = std::max(durableSeq, throughSeq);
+
+    // Rewrite the log with the records that were written after the mark
+    // (usually none); queued ones are appended by the flusher as usual
+    if (file) {
+        std::fclose(file);
+    }
+    AtomicFileWriter rewrite(path);
+    for (uint64_t seq = compactedSeq + 1; seq <= writtenSeq; ++seq) {
+        rewrite.stream() << records[seq - compactedSeq - 1] << '\n';
+    }
+    bool ok = rewrite.commit();
+
+    file = std::fopen(path.c_str(), "ab");
+    writeFailed = !ok || !file;
+    if (file && retrySeq > 0) {
+        retrySeq = 0;   // Let the flusher write what it had to hold back
+        recordsQueued.notify_one();
+    }
+    recordsDurable.notify_all();
+    return !writeFailed;
+}
+
+uint64_t Journal::getRecordCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return appendedSeq - compactedSeq;
+}
+
+uint64_t Journal::replay(const std::string& logPath,
+                         const std::function<void(std::string_view)>& apply) {
+    std::string contents;
+    if (!readWholeFile(logPath, contents)) {
+        return 0;
+    }
+
+    // Only newline-terminated records count; a torn tail is skipped
+    uint64_t applied = 0;
+    std::string_view text(contents);
+    size_t start = 0;
+    for (size_t end = text.find('\n'); end != std::string_view::npos;
+         start = end + 1, end = text.find('\n', start)) {
+        std::string_view record = text.substr(start, end - start);
+        if (!record.empty() && record.back() == '\r') {
+            record.remove_suffix(1);
+        }
+        if (!record.empty()) {
+            apply(record);
+            ++applied;
+        }
+    }
+    return applied;
+}
+
+void Journal::flusherLoop() {
+    std::string group;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            recordsQueued.wait(lock, [&]() {
+                return stopping || appendedSeq > std::max(writtenSeq, retrySeq);
+            });
+            if (appendedSeq == writtenSeq) {
+                return;   // Stopping and fully drained
+            }
+            if (stopping && appendedSeq == retrySeq) {
+                return;   // The log never came back; nothing more to try
+            }
+        }
+
+        // ioMutex keeps compact() out until this group is on disk;
+        // appenders only need mutex, so they keep queueing the next group
+        std::lock_guard<std::mutex> io(ioMutex);
+        if (!file) {
+            std::FILE* reopened = std::fopen(path.c_str(), "ab");
+            std::lock_guard<std::mutex> lock(mutex);
+            file = reopened;
+        }
+        uint64_t upTo;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            upTo = appendedSeq;
+            group.clear();
+            for (uint64_t seq = writtenSeq + 1; seq <= upTo; ++seq) {
+                group += records[seq - compactedSeq - 1];
+                group += '\n';
+            }
+        }
+
+        bool ok = file && std::fwrite(group.data(), 1, group.size(), file) == group.size() &&
+                  FileUtil::syncFile(file);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!file) {
+            // Keep the group queued; the next append retries the reopen
+            writeFailed = true;
+            retrySeq = upTo;
+            recordsDurable.notify_all();
+            continue;
+        }
+        if (!ok) {
+            writeFailed = true;
+        }
+        writtenSeq = upTo;
+        durableSeq = upTo;
+        recordsDurable.notify_all();
+    }
+}
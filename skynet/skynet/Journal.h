@@ -0,0 +1,120 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+/**
+ * @brief Append-only write-ahead log of text records
+ *
+ * Why a journal?
+ * - Saving used to rewrite every CSV after each edit, so one booking
+ *   cost I/O proportional to the whole database
+ * - A change is now one short record appended to the end of a log; the
+ *   base files are only rewritten when the log is compacted
+ *
+ * Why group commit?
+ * - append() just queues the record and returns
+ * - A flusher thread writes everything queued so far and fsyncs once;
+ *   records that arrive during that fsync form the next group, so a
+ *   burst of edits shares a handful of fsyncs instead of one each
+ * - sync() waits until every record appended before it is on disk
+ *
+ * Why sequence numbers?
+ * - Records are numbered as they are appended. A background save notes
+ *   getLastSequence() when it snapshots the data and afterwards calls
+ *   compact() with that mark, so edits made while it was writing stay
+ *   in the log
+ *
+ * On disk: one record per line. A crash can leave a last line without
+ * its newline; replay() ignores it and open() cuts it off, so the next
+ * record never gets glued to it. Records must not contain '\n'.
+ * Uncompacted records are also kept in memory, so compact() can rewrite
+ * the log without reading it back.
+ *
+ * If the log cannot be reopened after a compaction, the journal stays
+ * open: append() keeps queueing, the flusher retries the reopen with
+ * each new group, and sync() returns false until it succeeds.
+ */
+class Journal {
+public:
+    Journal();
+    ~Journal();   // Writes pending records, then stops the flusher
+
+    Journal(const Journal&) = delete;
+    Journal& operator=(const Journal&) = delete;
+
+    /**
+     * Open (or create) the log for appending and start the flusher
+     * @return false if the file cannot be opened
+     */
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const;
+
+    /**
+     * Queue one record; returns without waiting for the disk
+     * (ignored while the journal is closed)
+     */
+    void append(std::string record);
+
+    /**
+     * Block until all records appended so far are durable
+     * @return false if a write or fsync failed since the last compaction
+     */
+    bool sync();
+
+    // Sequence number of the last record appended (a compaction mark)
+    uint64_t getLastSequence() const;
+
+    /**
+     * Drop records up to and including throughSeq once they are part of
+     * the base files (compaction). Later records stay in the log; records
+     * still queued for writing are kept or dropped the same way.
+     * @return false if the log could not be rewritten (old records then
+     *         stay on disk, which replay tolerates)
+     */
+    bool compact(uint64_t throughSeq);
+
+    // Records in the log since it was opened or last compacted
+    uint64_t getRecordCount() const;
+
+    /**
+     * Read a log and hand every complete record to apply, in order
+     * @return Number of records applied (0 if the file does not exist)
+     */
+    static uint64_t replay(const std::string& path,
+                           const std::function<void(std::string_view)>& apply);
+
+private:
+    void flusherLoop();
+
+    std::string path;
+    std::FILE* file;   // nullptr while a reopen after compact() is pending
+    std::thread flusher;
+
+    // Guards the records and sequence counters
+    mutable std::mutex mutex;
+    std::condition_variable recordsQueued;
+    std::condition_variable recordsDurable;
+    std::deque<std::string> records;   // Sequences compactedSeq+1 .. appendedSeq
+    uint64_t compactedSeq;    // Last sequence folded into the base files
+    uint64_t writtenSeq;      // Last sequence written to the file
+    uint64_t durableSeq;      // Last sequence known to be on disk
+    uint64_t appendedSeq;     // Last sequence appended
+    uint64_t retrySeq;        // Unwritten for lack of a file; retried on the next append
+    bool opened;              // Between a successful open() and close()
+    bool writeFailed;
+    bool stopping;
+
+    // Held while the FILE is written or replaced; taken before mutex
+    std::mutex ioMutex;
+};
+
+#endif // JOURNAL_H
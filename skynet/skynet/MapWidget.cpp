@@ -61,28 +61,22 @@ void MapWidget::paintEvent(QPaintEvent *event) {
     painter.setPen(Qt::black);
     painter.drawText(10, 20, "Map View - Flight Network");
     painter.drawText(10, 40, QString("Airports: %1").arg(
-                                 DataStore::getInstance().getAllAirports().size()));
+                                 DataStore::getInstance().getAirportCount()));
     painter.drawText(10, 60, QString("Routes: %1").arg(
-                                 DataStore::getInstance().getAllRoutes().size()));
+                                 DataStore::getInstance().getRouteCount()));
 }
 
 void MapWidget::drawAirports(QPainter& painter) {
     DataStore& store = DataStore::getInstance();
-    auto airports = store.getAllAirports();
 
-    for (const auto& airport : airports) {
+    // Read the stored airports in place
+    for (const Airport& airport : store.viewAirports()) {
         QPoint pos = latLonToScreen(airport.latitude, airport.longitude);
 
         // Check if in optimal path
-        bool inPath = false;
-        if (hasPath) {
-            for (const auto& code : currentPath.path) {
-                if (code == airport.code) {
-                    inPath = true;
-                    break;
-                }
-            }
-        }
+        bool inPath = hasPath &&
+                      std::find(currentPath.path.begin(), currentPath.path.end(),
+                                airport.code) != currentPath.path.end();
 
         // Draw node
         if (inPath) {
@@ -103,28 +97,33 @@ void MapWidget::drawAirports(QPainter& painter) {
 }
 
 void MapWidget::drawRoutes(QPainter& painter) {
-    DataStore& store = DataStore::getInstance();
-    auto routes = store.getAllRoutes();
-    auto airports = store.getAllAirports();
-
-    // Create airport map for quick lookup
-    std::map<std::string, Airport> airportMap;
-    for (const auto& airport : airports) {
-        airportMap[airport.code] = airport;
-    }
+    // Held for the whole paint; carries the airport coordinates, so no
+    // per-edge lookups (operational routes only)
+    std::shared_ptr<const CompactGraph> graph = DataStore::getInstance().getCompactGraph();
+    const CompactGraph& cg = *graph;
 
     painter.setPen(QPen(QColor(100, 100, 100, 100), 1)); // Semi-transparent
 
-    for (const auto& route : routes) {
-        if (!route.operational) continue;
+    auto hasEdge = [&cg](CompactGraph::NodeId from, CompactGraph::NodeId to) {
+        for (uint32_t e = cg.edgeBegin(from); e < cg.edgeEnd(from); ++e) {
+            if (cg.edgeTarget(e) == to) return true;
+        }
+        return false;
+    };
+
+    for (CompactGraph::NodeId u = 0; u < cg.getNodeCount(); ++u) {
+        if (!cg.hasCoordinates(u)) continue;
 
-        auto it1 = airportMap.find(route.origin);
-        auto it2 = airportMap.find(route.destination);
+        QPoint p1 = latLonToScreen(cg.getLatitude(u), cg.getLongitude(u));
 
-        if (it1 != airportMap.end() && it2 != airportMap.end()) {
-            QPoint p1 = latLonToScreen(it1->second.latitude, it1->second.longitude);
-            QPoint p2 = latLonToScreen(it2->second.latitude, it2->second.longitude);
+        for (uint32_t e = cg.edgeBegin(u); e < cg.edgeEnd(u); ++e) {
+            CompactGraph::NodeId v = cg.edgeTarget(e);
+            // Bidirectional routes appear twice; draw each line once
+            if (!cg.hasCoordinates(v) || (v < u && hasEdge(v, u))) {
+                continue;
+            }
 
+            QPoint p2 = latLonToScreen(cg.getLatitude(v), cg.getLongitude(v));
             painter.drawLine(p1, p2);
         }
     }
@@ -171,7 +170,7 @@ QPoint MapWidget::latLonToScreen(double lat, double lon) const {
 
 void MapWidget::calculateBounds() {
     DataStore& store = DataStore::getInstance();
-    auto airports = store.getAllAirports();
+    auto airports = store.viewAirports();
 
     if (airports.empty()) {
         minLat = -90; maxLat = 90;
@@ -179,10 +178,10 @@ void MapWidget::calculateBounds() {
         return;
     }
 
-    minLat = maxLat = airports[0].latitude;
-    minLon = maxLon = airports[0].longitude;
+    minLat = maxLat = airports.begin()->latitude;
+    minLon = maxLon = airports.begin()->longitude;
 
-    for (const auto& airport : airports) {
+    for (const Airport& airport : airports) {
         minLat = std::min(minLat, airport.latitude);
         maxLat = std::max(maxLat, airport.latitude);
         minLon = std::min(minLon, airport.longitude);
@@ -0,0 +1,47 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Read-only memory mapping of a whole file
+ *
+ * Why map instead of read?
+ * - The OS pages the file in on demand straight from the page cache;
+ *   nothing is copied into a user buffer up front
+ * - Binary snapshots are laid out to be used in place, so "loading" is
+ *   mostly pointer arithmetic over the mapping
+ *
+ * Windows uses CreateFileMapping/MapViewOfFile, everything else mmap.
+ * The mapping lives until close() or destruction; pointers into it must
+ * not outlive the MappedFile.
+ */
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * Map a file read-only
+     * @return false if it cannot be opened or is empty
+     */
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return mapped != nullptr; }
+    const char* data() const { return static_cast<const char*>(mapped); }
+    size_t size() const { return length; }
+
+private:
+    void* mapped;
+    size_t length;
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#endif
+};
+
+#endif // MAPPEDFILE_H
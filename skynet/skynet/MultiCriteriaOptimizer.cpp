@@ -1,40 +1,277 @@
 #include "MultiCriteriaOptimizer.h"
-#include "Dijkstra.h"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <tuple>
 
-PathResult MultiCriteriaOptimizer::optimize(
-    const Graph& graph,
-    const std::string& start,
-    const std::string& end,
-    const Criteria& criteria) {
+namespace {
 
-    // For now, use standard Dijkstra
-    // Future: Implement weighted multi-criteria search
-    PathResult result = Dijkstra::findShortestPath(graph, start, end);
+using NodeId = CompactGraph::NodeId;
 
-    // Apply criteria filters
-    if (result.found && result.path.size() - 2 > criteria.maxStops) {
-        result.found = false;
-        result.errorMessage = "Exceeds maximum stops constraint";
+const uint32_t NO_LABEL = std::numeric_limits<uint32_t>::max();
+
+// One way of reaching `node`; parent and nextInBag are pool indexes
+struct Label {
+    double distance;
+    double cost;
+    double time;
+    NodeId node;
+    uint32_t parent;
+    uint32_t nextInBag;
+    uint16_t legs;
+    bool alive;
+};
+
+// Lexicographic (distance, cost, legs) order, so a label leaves the heap
+// only after every label that could dominate it
+struct HeapEntry {
+    double distance;
+    double cost;
+    uint32_t legs;
+    uint32_t label;
+
+    bool operator>(const HeapEntry& other) const {
+        return std::tie(distance, cost, legs, label) >
+               std::tie(other.distance, other.cost, other.legs, other.label);
     }
+};
 
-    return result;
+// Kept per thread between searches; cleared, not freed
+struct Workspace {
+    std::vector<Label> pool;
+    std::vector<HeapEntry> heap;
+    std::vector<uint32_t> bagHead;   // Per node, NO_LABEL when empty
+    std::vector<NodeId> touched;     // Nodes whose bagHead is set
+    std::vector<uint32_t> arrivals;  // Final labels at the destination
+};
+
+Workspace& getWorkspace() {
+    thread_local Workspace workspace;
+    return workspace;
 }
 
-std::vector<PathResult> MultiCriteriaOptimizer::getParetoFrontier(
-    const Graph& graph,
-    const std::string& start,
-    const std::string& end) {
+// Does `a` cover the candidate: no worse anywhere, within `factor`?
+bool covers(const Label& a, double distance, double cost, double time, uint16_t legs,
+            double factor) {
+    return a.legs <= legs && a.distance <= distance * factor &&
+           a.cost <= cost * factor && a.time <= time * factor;
+}
 
+bool bagCovers(const Workspace& ws, NodeId node, double distance, double cost,
+               double time, uint16_t legs, double factor) {
+    for (uint32_t i = ws.bagHead[node]; i != NO_LABEL; i = ws.pool[i].nextInBag) {
+        if (covers(ws.pool[i], distance, cost, time, legs, factor)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Unlink and kill the labels at node that the candidate dominates
+void evictDominated(Workspace& ws, NodeId node, double distance, double cost,
+                    double time, uint16_t legs) {
+    uint32_t* link = &ws.bagHead[node];
+    while (*link != NO_LABEL) {
+        Label& label = ws.pool[*link];
+        if (legs <= label.legs && distance <= label.distance && cost <= label.cost &&
+            time <= label.time) {
+            label.alive = false;
+            *link = label.nextInBag;
+        } else {
+            link = &label.nextInBag;
+        }
+    }
+}
+
+PathResult buildResult(const CompactGraph& graph, const Workspace& ws, uint32_t index,
+                       int labelsSettled) {
+    PathResult result;
+    result.found = true;
+    for (uint32_t i = index; i != NO_LABEL; i = ws.pool[i].parent) {
+        result.path.push_back(graph.getNodeCode(ws.pool[i].node));
+    }
+    std::reverse(result.path.begin(), result.path.end());
+
+    const Label& label = ws.pool[index];
+    result.totalDistance = label.distance;
+    result.totalCost = label.cost;
+    result.estimatedTime = label.time;
+    result.nodesExpanded = labelsSettled;
+    return result;
+}
+
+std::vector<PathResult> paretoSearch(const CompactGraph& graph,
+                                     const std::string& start,
+                                     const std::string& end,
+                                     const MultiCriteriaOptimizer::ParetoOptions& options) {
     std::vector<PathResult> frontier;
+    const NodeId source = graph.getNodeId(start);
+    const NodeId target = graph.getNodeId(end);
+    if (source == CompactGraph::INVALID_NODE || target == CompactGraph::INVALID_NODE) {
+        return frontier;
+    }
+    if (source == target) {
+        frontier.emplace_back(true, std::vector<std::string>{start}, 0.0, 0.0, 0.0);
+        return frontier;
+    }
+
+    Workspace& ws = getWorkspace();
+    if (ws.bagHead.size() < graph.getNodeCount()) {
+        ws.bagHead.resize(graph.getNodeCount(), NO_LABEL);
+    }
+    ws.pool.clear();
+    ws.heap.clear();
+    ws.touched.clear();
+    ws.arrivals.clear();
+
+    const double factor = 1.0 + std::max(0.0, options.epsilon);
+    const uint16_t maxLegs = static_cast<uint16_t>(
+        std::min(std::max(options.maxStops, 0) + 1, int(std::numeric_limits<uint16_t>::max())));
+    const size_t maxLabels = std::max<size_t>(1, options.maxLabels);
+
+    auto addLabel = [&](NodeId node, double distance, double cost, double time,
+                        uint16_t legs, uint32_t parent) {
+        const uint32_t index = static_cast<uint32_t>(ws.pool.size());
+        if (ws.bagHead[node] == NO_LABEL) {
+            ws.touched.push_back(node);
+        }
+        ws.pool.push_back(Label{distance, cost, time, node, parent, ws.bagHead[node], legs, true});
+        ws.bagHead[node] = index;
+        ws.heap.push_back(HeapEntry{distance, cost, legs, index});
+        std::push_heap(ws.heap.begin(), ws.heap.end(), std::greater<HeapEntry>());
+    };
+
+    addLabel(source, 0.0, 0.0, 0.0, 0, NO_LABEL);
+    int settled = 0;
+
+    while (!ws.heap.empty()) {
+        std::pop_heap(ws.heap.begin(), ws.heap.end(), std::greater<HeapEntry>());
+        const uint32_t index = ws.heap.back().label;
+        ws.heap.pop_back();
 
-    // Generate multiple paths with different criteria weights
-    Criteria c1{1.0, 0.0, 0.0, 5}; // Distance priority
-    Criteria c2{0.0, 1.0, 0.0, 5}; // Cost priority
-    Criteria c3{0.0, 0.0, 1.0, 5}; // Time priority
+        // Copy: adding labels may move the pool
+        const Label label = ws.pool[index];
+        if (!label.alive) continue;
+        ++settled;
 
-    frontier.push_back(optimize(graph, start, end, c1));
-    frontier.push_back(optimize(graph, start, end, c2));
-    frontier.push_back(optimize(graph, start, end, c3));
+        if (label.node == target) {
+            ws.arrivals.push_back(index);
+            continue;
+        }
+        if (label.legs >= maxLegs) continue;
+
+        const uint16_t legs = label.legs + 1;
+        const double connection = label.legs > 0 ? MultiCriteriaOptimizer::CONNECTION_HOURS : 0.0;
+        for (uint32_t e = graph.edgeBegin(label.node); e < graph.edgeEnd(label.node); ++e) {
+            const NodeId next = graph.edgeTarget(e);
+            const double distance = label.distance + graph.edgeWeight(e);
+            const double cost = label.cost + graph.edgeCost(e);
+            const double time = label.time + connection +
+                                graph.edgeWeight(e) / MultiCriteriaOptimizer::CRUISE_SPEED_KMH;
+
+            // Dominated by a way to the destination, or to this airport
+            if (bagCovers(ws, target, distance, cost, time, legs, factor) ||
+                (next != target && bagCovers(ws, next, distance, cost, time, legs, factor))) {
+                continue;
+            }
+            if (ws.pool.size() >= maxLabels) {
+                break;
+            }
+
+            evictDominated(ws, next, distance, cost, time, legs);
+            addLabel(next, distance, cost, time, legs, index);
+        }
+    }
 
+    frontier.reserve(ws.arrivals.size());
+    for (uint32_t index : ws.arrivals) {
+        frontier.push_back(buildResult(graph, ws, index, settled));
+    }
+
+    for (NodeId node : ws.touched) {
+        ws.bagHead[node] = NO_LABEL;
+    }
     return frontier;
 }
+
+PathResult optimizeOn(const CompactGraph& graph,
+                      const std::string& start,
+                      const std::string& end,
+                      const MultiCriteriaOptimizer::Criteria& criteria) {
+    MultiCriteriaOptimizer::ParetoOptions options;
+    options.maxStops = static_cast<int>(std::max(0.0, criteria.maxStops));
+    std::vector<PathResult> frontier = paretoSearch(graph, start, end, options);
+
+    if (frontier.empty()) {
+        PathResult result;
+        if (!graph.hasNode(start)) {
+            result.errorMessage = "Origin airport not found";
+        } else if (!graph.hasNode(end)) {
+            result.errorMessage = "Destination airport not found";
+        } else {
+            result.errorMessage = "No route within the maximum stops constraint";
+        }
+        return result;
+    }
+
+    // Scale each criterion by its best value so the weights compare
+    // like with like
+    double bestDistance = std::numeric_limits<double>::infinity();
+    double bestCost = bestDistance;
+    double bestTime = bestDistance;
+    for (const PathResult& path : frontier) {
+        bestDistance = std::min(bestDistance, path.totalDistance);
+        bestCost = std::min(bestCost, path.totalCost);
+        bestTime = std::min(bestTime, path.estimatedTime);
+    }
+    auto scaled = [](double value, double best) { return best > 0.0 ? value / best : value; };
+
+    size_t chosen = 0;
+    double chosenScore = std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < frontier.size(); ++i) {
+        const PathResult& path = frontier[i];
+        double score = criteria.distanceWeight * scaled(path.totalDistance, bestDistance) +
+                       criteria.costWeight * scaled(path.totalCost, bestCost) +
+                       criteria.timeWeight * scaled(path.estimatedTime, bestTime);
+        if (score < chosenScore) {
+            chosenScore = score;
+            chosen = i;
+        }
+    }
+    return frontier[chosen];
+}
+
+} // namespace
+
+PathResult MultiCriteriaOptimizer::optimize(
+    const Graph& graph,
+    const std::string& start,
+    const std::string& end,
+    const Criteria& criteria) {
+    return optimizeOn(CompactGraph(graph), start, end, criteria);
+}
+
+PathResult MultiCriteriaOptimizer::optimize(
+    const CompactGraph& graph,
+    const std::string& start,
+    const std::string& end,
+    const Criteria& criteria) {
+    return optimizeOn(graph, start, end, criteria);
+}
+
+std::vector<PathResult> MultiCriteriaOptimizer::getParetoFrontier(
+    const Graph& graph,
+    const std::string& start,
+    const std::string& end,
+    const ParetoOptions& options) {
+    return paretoSearch(CompactGraph(graph), start, end, options);
+}
+
+std::vector<PathResult> MultiCriteriaOptimizer::getParetoFrontier(
+    const CompactGraph& graph,
+    const std::string& start,
+    const std::string& end,
+    const ParetoOptions& options) {
+    return paretoSearch(graph, start, end, options);
+}
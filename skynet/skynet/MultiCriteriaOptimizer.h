@@ -1,7 +1,9 @@
 #ifndef MULTICRITERIAOPTIMIZER_H
 #define MULTICRITERIAOPTIMIZER_H
 #include "Graph.h"
+#include "CompactGraph.h"
 #include "PathResult.h"
+#include <cstddef>
 #include <vector>
 
 /**
@@ -13,10 +15,42 @@
  * - Time (minimize)
  * - Comfort (maximize - based on stops)
  *
- * Uses weighted sum approach or Pareto frontier generation
+ * Why label setting?
+ * - A single Dijkstra minimizes one value; running it once per weight
+ *   set returned the same distance-shortest path every time
+ * - Here every airport keeps a bag of labels (distance, cost, time,
+ *   stops), one per non-dominated way of reaching it. Labels leave a
+ *   heap in lexicographic order, so a label that leaves it undominated
+ *   is final; a new label is dropped if a label in its airport's bag or
+ *   at the destination dominates it, and it evicts the labels it
+ *   dominates
+ * - Every label that reaches the destination is one point of the exact
+ *   Pareto frontier
+ *
+ * Why a label pool?
+ * - Labels live in one contiguous array and point to their parent and
+ *   bag neighbor by index, not by pointer; bags are linked lists through
+ *   the pool. The pool, heap and bag heads are kept per thread between
+ *   searches, so a warm search allocates only its results
+ *
+ * Bounding the frontier:
+ * - maxStops caps the path length, which also bounds the bags
+ * - epsilon > 0 drops a new label if an existing one is within a factor
+ *   of (1 + epsilon) on every criterion. Each dropped tradeoff stays
+ *   close to a kept one, and hub networks need far fewer labels
+ * - maxLabels caps the pool; a search that hits it returns the
+ *   frontier found so far
+ *
+ * Time is not stored on the network: a leg takes distance /
+ * CRUISE_SPEED_KMH hours, and each stop adds CONNECTION_HOURS. Time
+ * therefore follows from distance and stops and never adds frontier
+ * points of its own; it is reported and weighed by optimize().
  */
 class MultiCriteriaOptimizer {
 public:
+    static constexpr double CRUISE_SPEED_KMH = 800.0;
+    static constexpr double CONNECTION_HOURS = 1.0;
+
     struct Criteria {
         double distanceWeight = 0.4;
         double costWeight = 0.3;
@@ -24,26 +58,49 @@ public:
         double maxStops = 3;
     };
 
+    struct ParetoOptions {
+        int maxStops;       // Intermediate airports allowed
+        double epsilon;     // 0 = exact frontier
+        size_t maxLabels;   // Pool cap; bounds memory on dense networks
+
+        ParetoOptions() : maxStops(3), epsilon(0.0), maxLabels(1 << 20) {}
+    };
+
     /**
      * Find optimal path considering multiple criteria
      * @param graph Flight network
      * @param start Origin airport
      * @param end Destination airport
      * @param criteria Optimization weights
-     * @return Best path according to weighted criteria
+     * @return The frontier path with the lowest weighted sum, each
+     *         criterion scaled by its best value on the frontier
      */
     static PathResult optimize(const Graph& graph,
                                const std::string& start,
                                const std::string& end,
                                const Criteria& criteria);
 
+    static PathResult optimize(const CompactGraph& graph,
+                               const std::string& start,
+                               const std::string& end,
+                               const Criteria& criteria);
+
     /**
      * Generate Pareto frontier of non-dominated solutions
-     * @return Vector of paths representing tradeoff options
+     * @return Every non-dominated path (one per distinct tradeoff),
+     *         shortest first; empty if the airports are unknown or not
+     *         connected within maxStops
      */
     static std::vector<PathResult> getParetoFrontier(
         const Graph& graph,
         const std::string& start,
-        const std::string& end);
+        const std::string& end,
+        const ParetoOptions& options = ParetoOptions());
+
+    static std::vector<PathResult> getParetoFrontier(
+        const CompactGraph& graph,
+        const std::string& start,
+        const std::string& end,
+        const ParetoOptions& options = ParetoOptions());
 };
 #endif // MULTICRITERIAOPTIMIZER_H
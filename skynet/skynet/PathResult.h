@@ -19,14 +19,15 @@ struct PathResult {
     double totalCost;                // Estimated cost
     double estimatedTime;            // Hours
     std::string errorMessage;        // If not found, why?
+    int nodesExpanded;               // Nodes settled by the search
 
     PathResult() : found(false), totalDistance(0.0),
-        totalCost(0.0), estimatedTime(0.0) {}
+        totalCost(0.0), estimatedTime(0.0), nodesExpanded(0) {}
 
     PathResult(bool f, const std::vector<std::string>& p,
                double dist, double cost, double time)
         : found(f), path(p), totalDistance(dist),
-        totalCost(cost), estimatedTime(time) {}
+        totalCost(cost), estimatedTime(time), nodesExpanded(0) {}
 
     // Quick check if path exists and is valid
     bool isValid() const {
@@ -0,0 +1,83 @@
+#include "PersistenceService.h"
+#include <exception>
+#include <future>
+#include <iostream>
+
+PersistenceService::PersistenceService()
+    : running(false), stopping(false) {
+    worker = std::thread(&PersistenceService::workerLoop, this);
+}
+
+PersistenceService::~PersistenceService() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    jobReady.notify_one();
+    worker.join();
+}
+
+void PersistenceService::submit(Job job, Callback done) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        waitingJob = std::move(job);   // Supersedes a job that has not started
+        if (done) {
+            waitingCallbacks.push_back(std::move(done));
+        }
+    }
+    jobReady.notify_one();
+}
+
+bool PersistenceService::run(Job job) {
+    std::promise<bool> finished;
+    std::future<bool> result = finished.get_future();
+    submit(std::move(job), [&finished](bool success) { finished.set_value(success); });
+    return result.get();
+}
+
+void PersistenceService::waitIdle() {
+    std::unique_lock<std::mutex> lock(mutex);
+    jobsDone.wait(lock, [this]() { return !running && !waitingJob; });
+}
+
+bool PersistenceService::isBusy() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return running || static_cast<bool>(waitingJob);
+}
+
+void PersistenceService::workerLoop() {
+    while (true) {
+        Job job;
+        std::vector<Callback> callbacks;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            jobReady.wait(lock, [this]() { return stopping || waitingJob; });
+
+            // Finish the waiting job before honoring shutdown
+            if (!waitingJob) {
+                return;
+            }
+            job = std::move(waitingJob);
+            waitingJob = nullptr;
+            callbacks.swap(waitingCallbacks);
+            running = true;
+        }
+
+        bool success = false;
+        try {
+            success = job();
+        } catch (const std::exception& e) {
+            std::cerr << "Error saving data: " << e.what() << std::endl;
+        }
+
+        for (const Callback& callback : callbacks) {
+            callback(success);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            running = false;
+        }
+        jobsDone.notify_all();
+    }
+}
@@ -0,0 +1,71 @@
+#ifndef PERSISTENCESERVICE_H
+#define PERSISTENCESERVICE_H
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Background thread that runs save jobs, newest request wins
+ *
+ * Why a separate thread?
+ * - Serializing and writing the data files took seconds on large data
+ *   sets; on the GUI thread the window froze for the whole save
+ * - The caller builds a job around a consistent snapshot of the data
+ *   (see DataStore::saveAllAsync) and returns at once; formatting,
+ *   writing and fsync happen here
+ *
+ * Why coalesce?
+ * - At most one job runs and one waits. Submitting while another job is
+ *   still waiting replaces it: the newer snapshot supersedes the older
+ *   one, so a burst of save requests costs at most two writes
+ * - The replaced job's callbacks are kept and report the outcome of the
+ *   job that replaced it
+ *
+ * Callbacks run on the service thread; Qt callers post them back to the
+ * GUI thread (QMetaObject::invokeMethod with Qt::QueuedConnection).
+ *
+ * The destructor finishes the running and waiting jobs before joining.
+ */
+class PersistenceService {
+public:
+    using Job = std::function<bool()>;
+    using Callback = std::function<void(bool success)>;
+
+    PersistenceService();
+    ~PersistenceService();
+
+    PersistenceService(const PersistenceService&) = delete;
+    PersistenceService& operator=(const PersistenceService&) = delete;
+
+    /**
+     * Queue a job, replacing one that has not started yet
+     * @param done Called with the job's result (or its replacement's)
+     */
+    void submit(Job job, Callback done = Callback());
+
+    /**
+     * Queue a job and wait for it
+     * @return The job's result (or its replacement's)
+     */
+    bool run(Job job);
+
+    // Block until no job is running or waiting
+    void waitIdle();
+    bool isBusy() const;
+
+private:
+    void workerLoop();
+
+    std::thread worker;
+    mutable std::mutex mutex;
+    std::condition_variable jobReady;
+    std::condition_variable jobsDone;
+    Job waitingJob;
+    std::vector<Callback> waitingCallbacks;
+    bool running;
+    bool stopping;
+};
+
+#endif // PERSISTENCESERVICE_H
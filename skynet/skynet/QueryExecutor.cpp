@@ -0,0 +1,172 @@
+#include "QueryExecutor.h"
+#include "SearchEngine.h"
+#include <algorithm>
+#include <exception>
+#include <iostream>
+
+QueryExecutor::QueryExecutor(unsigned threadCount)
+    : stopping(false) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    workers.reserve(threadCount);
+    for (unsigned t = 0; t < threadCount; ++t) {
+        workers.emplace_back(&QueryExecutor::workerLoop, this);
+    }
+    builder = std::thread(&QueryExecutor::builderLoop, this);
+}
+
+QueryExecutor::~QueryExecutor() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    taskReady.notify_all();
+    buildReady.notify_all();
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    builder.join();
+}
+
+std::future<PathResult> QueryExecutor::submit(const Network& network, const Query& query) {
+    Task task{network, query, std::promise<PathResult>(), Callback()};
+    std::future<PathResult> future = task.promise.get_future();
+    enqueue(std::move(task));
+    return future;
+}
+
+void QueryExecutor::submit(const Network& network, const Query& query, Callback callback) {
+    enqueue(Task{network, query, std::promise<PathResult>(), std::move(callback)});
+}
+
+std::vector<std::future<PathResult>> QueryExecutor::submitBatch(const Network& network,
+                                                                const std::vector<Query>& queries) {
+    std::vector<std::future<PathResult>> futures;
+    futures.reserve(queries.size());
+
+    for (const auto& query : queries) {
+        futures.push_back(submit(network, query));
+    }
+    return futures;
+}
+
+std::vector<PathResult> QueryExecutor::runBatch(const Network& network,
+                                                const std::vector<Query>& queries) {
+    std::vector<std::future<PathResult>> futures = submitBatch(network, queries);
+
+    std::vector<PathResult> results;
+    results.reserve(futures.size());
+    for (auto& future : futures) {
+        results.push_back(future.get());
+    }
+    return results;
+}
+
+void QueryExecutor::enqueue(Task task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(task));
+    }
+    taskReady.notify_one();
+}
+
+void QueryExecutor::workerLoop() {
+    // Per-worker workspaces, reused across every query this thread runs
+    SearchEngine engine;
+    CHQuery chQuery;
+
+    while (true) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            taskReady.wait(lock, [this]() { return stopping || !tasks.empty(); });
+
+            // Drain the queue before honoring shutdown
+            if (tasks.empty()) {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+
+        // Never wait for the snapshot's hierarchy: building it can take
+        // seconds, so answer without it until the builder is done
+        std::shared_ptr<const ContractionHierarchy> hierarchy = task.network.hierarchy;
+        if (!hierarchy && task.network.snapshot && task.query.criterion == Criterion::DISTANCE) {
+            hierarchy = task.network.snapshot->tryGetContractionHierarchy();
+            if (!hierarchy) {
+                requestHierarchy(task.network.snapshot);
+            }
+        }
+
+        PathResult result;
+        try {
+            if (!task.network.graph) {
+                result.errorMessage = "No route network available";
+            } else if (task.query.criterion == Criterion::COST) {
+                result = engine.findCheapestPath(*task.network.graph,
+                                                 task.query.origin, task.query.destination);
+            } else if (hierarchy) {
+                result = chQuery.findShortestPath(*hierarchy,
+                                                  task.query.origin, task.query.destination);
+            } else {
+                result = engine.findShortestPathBidirectional(*task.network.graph,
+                                                              task.query.origin,
+                                                              task.query.destination);
+            }
+        } catch (const std::exception& e) {
+            result = PathResult();
+            result.errorMessage = std::string("Route search failed: ") + e.what();
+        }
+
+        if (task.callback) {
+            try {
+                task.callback(result);
+            } catch (const std::exception& e) {
+                std::cerr << "Error in route query callback: " << e.what() << std::endl;
+            } catch (...) {
+                std::cerr << "Error in route query callback" << std::endl;
+            }
+        } else {
+            task.promise.set_value(std::move(result));
+        }
+    }
+}
+
+void QueryExecutor::requestHierarchy(const std::shared_ptr<const GraphSnapshot>& snapshot) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopping || snapshot == currentBuild || snapshot == pendingBuild) {
+            return;
+        }
+        // Newest wins: an older snapshot still waiting is dropped
+        pendingBuild = snapshot;
+    }
+    buildReady.notify_one();
+}
+
+void QueryExecutor::builderLoop() {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            currentBuild.reset();
+            buildReady.wait(lock, [this]() { return stopping || pendingBuild; });
+
+            // Pending builds are dropped on shutdown; nobody will query them
+            if (stopping) {
+                return;
+            }
+            currentBuild = std::move(pendingBuild);
+            pendingBuild.reset();
+        }
+
+        try {
+            currentBuild->getContractionHierarchy();
+        } catch (const std::exception& e) {
+            std::cerr << "Error building contraction hierarchy: " << e.what() << std::endl;
+        }
+    }
+}
@@ -0,0 +1,136 @@
+#ifndef QUERYEXECUTOR_H
+#define QUERYEXECUTOR_H
+#include "CompactGraph.h"
+#include "ContractionHierarchy.h"
+#include "GraphSnapshot.h"
+#include "PathResult.h"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Worker pool that answers route queries off the calling thread
+ *
+ * Why a pool?
+ * - Route searches used to run on the GUI thread, freezing the window
+ *   for the duration of the search
+ * - Batches of independent queries (what-if planning, reports) spread
+ *   across cores: each worker owns its own SearchEngine/CHQuery
+ *   workspace, so workers never share mutable state
+ *
+ * Why pass a Network with every query?
+ * - The CompactGraph and ContractionHierarchy are immutable once built;
+ *   holding shared_ptrs keeps the snapshot alive while queries run, even
+ *   if DataStore rebuilds the graph in the meantime
+ * - A Network may carry the GraphSnapshot instead of a hierarchy. If
+ *   the snapshot's hierarchy is ready the worker uses it; otherwise the
+ *   worker answers with a bidirectional search and hands the snapshot to
+ *   a builder thread. Neither the submitting thread nor the workers wait
+ *   for the one-time preprocessing after an edit
+ * - The builder only keeps the newest request: a snapshot superseded
+ *   before its build starts is never preprocessed
+ *
+ * A search or callback that throws does not take its worker down: the
+ * exception becomes the result's errorMessage (or is logged, if the
+ * callback threw).
+ *
+ * Results are delivered through std::future or a callback. Callbacks run
+ * on a worker thread; Qt callers post them back to the GUI thread
+ * (QMetaObject::invokeMethod with Qt::QueuedConnection).
+ *
+ * The destructor finishes queued queries before joining the workers.
+ */
+class QueryExecutor {
+public:
+    enum class Criterion {
+        DISTANCE,   // Shortest km (uses the hierarchy when available)
+        COST        // Lowest operational cost
+    };
+
+    struct Query {
+        std::string origin;
+        std::string destination;
+        Criterion criterion;
+
+        Query() : criterion(Criterion::DISTANCE) {}
+        Query(const std::string& origin, const std::string& destination,
+              Criterion criterion = Criterion::DISTANCE)
+            : origin(origin), destination(destination), criterion(criterion) {}
+    };
+
+    // Immutable routing data a query runs against
+    struct Network {
+        std::shared_ptr<const CompactGraph> graph;
+        std::shared_ptr<const ContractionHierarchy> hierarchy;   // Optional
+        std::shared_ptr<const GraphSnapshot> snapshot;   // Optional: hierarchy built in the background
+    };
+
+    using Callback = std::function<void(const PathResult&)>;
+
+    /**
+     * @param threadCount Worker threads; 0 = hardware concurrency
+     */
+    explicit QueryExecutor(unsigned threadCount = 0);
+    ~QueryExecutor();
+
+    QueryExecutor(const QueryExecutor&) = delete;
+    QueryExecutor& operator=(const QueryExecutor&) = delete;
+
+    unsigned getThreadCount() const { return static_cast<unsigned>(workers.size()); }
+
+    /**
+     * Queue one query
+     * @return Future that becomes ready when a worker has answered it
+     */
+    std::future<PathResult> submit(const Network& network, const Query& query);
+
+    /**
+     * Queue one query and call callback (on a worker thread) with the result
+     */
+    void submit(const Network& network, const Query& query, Callback callback);
+
+    /**
+     * Queue a batch; futures are in the same order as queries
+     */
+    std::vector<std::future<PathResult>> submitBatch(const Network& network,
+                                                     const std::vector<Query>& queries);
+
+    /**
+     * Run a batch and wait for all of it
+     */
+    std::vector<PathResult> runBatch(const Network& network,
+                                     const std::vector<Query>& queries);
+
+private:
+    struct Task {
+        Network network;
+        Query query;
+        std::promise<PathResult> promise;
+        Callback callback;   // Empty when the result goes to the promise
+    };
+
+    void enqueue(Task task);
+    void workerLoop();
+    void requestHierarchy(const std::shared_ptr<const GraphSnapshot>& snapshot);
+    void builderLoop();
+
+    std::vector<std::thread> workers;
+    std::deque<Task> tasks;
+    std::mutex mutex;
+    std::condition_variable taskReady;
+    bool stopping;
+
+    // Hierarchy preprocessing, one snapshot at a time
+    std::thread builder;
+    std::shared_ptr<const GraphSnapshot> pendingBuild;
+    std::shared_ptr<const GraphSnapshot> currentBuild;
+    std::condition_variable buildReady;
+};
+
+#endif // QUERYEXECUTOR_H
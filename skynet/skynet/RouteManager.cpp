@@ -65,12 +65,10 @@ void RouteManager::loadAirports() {
     destCombo->clear();
 
     DataStore& store = DataStore::getInstance();
-    auto airports = store.getAllAirports();
-
-    for (const auto& airport : airports) {
-        QString display = QString::fromStdString(airport.code + " - " + airport.name);
-        originCombo->addItem(display, QString::fromStdString(airport.code));
-        destCombo->addItem(display, QString::fromStdString(airport.code));
+    for (const Airport* airport : store.getAirportTable().valuesByKey()) {
+        QString display = QString::fromStdString(airport->code + " - " + airport->name);
+        originCombo->addItem(display, QString::fromStdString(airport->code));
+        destCombo->addItem(display, QString::fromStdString(airport->code));
     }
 }
 
@@ -78,17 +76,17 @@ void RouteManager::loadRoutes() {
     table->setRowCount(0);
 
     DataStore& store = DataStore::getInstance();
-    auto routes = store.getAllRoutes();
-
-    for (const auto& route : routes) {
-        int row = table->rowCount();
-        table->insertRow(row);
+    table->setRowCount(static_cast<int>(store.getRouteCount()));
 
+    int row = 0;
+    for (const Route* record : store.getRouteTable().valuesByKey()) {
+        const Route& route = *record;
         table->setItem(row, 0, new QTableWidgetItem(QString::fromStdString(route.origin)));
         table->setItem(row, 1, new QTableWidgetItem(QString::fromStdString(route.destination)));
         table->setItem(row, 2, new QTableWidgetItem(QString::number(route.distance, 'f', 2)));
         table->setItem(row, 3, new QTableWidgetItem(QString::number(route.baseCost, 'f', 2)));
         table->setItem(row, 4, new QTableWidgetItem(route.operational ? "Active" : "Inactive"));
+        ++row;
     }
 }
 
@@ -128,7 +126,7 @@ void RouteManager::onAdd() {
                                  QString("Route added: %1 → %2 (%3 km)\nDistance calculated automatically using Haversine formula.")
                                      .arg(origin).arg(dest).arg(distance, 0, 'f', 2));
 
-        store.saveAll();
+        store.syncJournal();
         loadRoutes();
     } else {
         QMessageBox::warning(this, "Error", "Route already exists.");
@@ -154,7 +152,7 @@ void RouteManager::onDelete() {
         DataStore& store = DataStore::getInstance();
         if (store.deleteRoute(routeId.toStdString())) {
             QMessageBox::information(this, "Success", "Route deleted.");
-            store.saveAll();
+            store.syncJournal();
             loadRoutes();
         }
     }
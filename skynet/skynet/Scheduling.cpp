@@ -1,47 +1,132 @@
 #include "Scheduling.h"
+#include "DataStore.h"
+#include "TimeUtil.h"
+#include <algorithm>
+#include <cmath>
+#include <string_view>
+#include <unordered_map>
+
+namespace {
+
+bool isScheduled(const Flight& flight) {
+    return flight.status == "SCHEDULED";
+}
+
+int64_t flightMinutes(const Flight& flight) {
+    return static_cast<int64_t>(std::llround(flight.estimatedTime * 60.0));
+}
+
+// A flight's window on its aircraft
+struct Window {
+    int64_t start;
+    int64_t end;
+    const Flight* flight;
+};
+
+// Sweep each aircraft's windows in start order. `open` holds the windows
+// that have not ended yet; each new window conflicts with all of them.
+template <typename Flights>
+std::vector<std::pair<std::string, std::string>> sweepConflicts(const Flights& flights) {
+    std::unordered_map<std::string_view, std::vector<Window>> byAircraft;
+    for (const Flight& flight : flights) {
+        Window window{0, 0, &flight};
+        if (isScheduled(flight) && Scheduling::getTimeWindow(flight, window.start, window.end)) {
+            byAircraft[flight.aircraftId].push_back(window);
+        }
+    }
+
+    // Aircraft in id order, so the result does not depend on hashing
+    std::vector<std::string_view> aircraftIds;
+    aircraftIds.reserve(byAircraft.size());
+    for (const auto& [id, windows] : byAircraft) {
+        aircraftIds.push_back(id);
+    }
+    std::sort(aircraftIds.begin(), aircraftIds.end());
+
+    std::vector<std::pair<std::string, std::string>> conflicts;
+    std::vector<Window> open;
+    for (std::string_view id : aircraftIds) {
+        std::vector<Window>& windows = byAircraft[id];
+        std::sort(windows.begin(), windows.end(), [](const Window& a, const Window& b) {
+            return a.start != b.start ? a.start < b.start
+                                      : a.flight->flightNumber < b.flight->flightNumber;
+        });
+
+        open.clear();
+        for (const Window& window : windows) {
+            // Every window dropped here or kept and reported is paid for
+            // by an end or a conflict, so the sweep stays O(n + conflicts)
+            open.erase(std::remove_if(open.begin(), open.end(),
+                                      [&](const Window& o) { return o.end <= window.start; }),
+                       open.end());
+            for (const Window& o : open) {
+                conflicts.emplace_back(o.flight->flightNumber, window.flight->flightNumber);
+            }
+            open.push_back(window);
+        }
+    }
+    return conflicts;
+}
+
+} // namespace
+
+bool Scheduling::getTimeWindow(const Flight& flight, int64_t& start, int64_t& end) {
+    start = TimeUtil::parseMinutes(flight.departureTime);
+    if (start == TimeUtil::NO_TIME) {
+        return false;
+    }
+    end = start + flightMinutes(flight) + TURNAROUND_MINUTES;
+    return true;
+}
 
 bool Scheduling::canSchedule(const Flight& flight,
                              const std::vector<Flight>& existingFlights) {
-    // Check if aircraft is available
+    int64_t start, end;
+    if (!getTimeWindow(flight, start, end)) {
+        return false;
+    }
     for (const auto& existing : existingFlights) {
-        if (existing.aircraftId == flight.aircraftId &&
-            existing.status == "SCHEDULED") {
-            // Simplified: assume conflict if same aircraft
+        int64_t otherStart, otherEnd;
+        if (existing.aircraftId == flight.aircraftId && isScheduled(existing) &&
+            getTimeWindow(existing, otherStart, otherEnd) &&
+            otherStart < end && start < otherEnd) {
             return false;
         }
     }
     return true;
 }
 
+bool Scheduling::canSchedule(const Flight& flight, const DataStore& store) {
+    int64_t start, end;
+    return getTimeWindow(flight, start, end) && store.findScheduleConflicts(flight).empty();
+}
+
 std::vector<std::pair<std::string, std::string>>
 Scheduling::detectConflicts(const std::vector<Flight>& flights) {
-    std::vector<std::pair<std::string, std::string>> conflicts;
-
-    for (size_t i = 0; i < flights.size(); ++i) {
-        for (size_t j = i + 1; j < flights.size(); ++j) {
-            if (flights[i].aircraftId == flights[j].aircraftId &&
-                flights[i].status == "SCHEDULED" &&
-                flights[j].status == "SCHEDULED") {
-                conflicts.push_back({flights[i].flightNumber,
-                                     flights[j].flightNumber});
-            }
-        }
-    }
+    return sweepConflicts(flights);
+}
 
-    return conflicts;
+std::vector<std::pair<std::string, std::string>>
+Scheduling::detectConflicts(const DataStore& store) {
+    return sweepConflicts(store.viewFlights());
 }
 
 std::vector<Scheduling::TimeSlot>
 Scheduling::generateGanttData(const std::vector<Flight>& flights) {
     std::vector<TimeSlot> slots;
+    slots.reserve(flights.size());
 
     for (const auto& flight : flights) {
         TimeSlot slot;
         slot.aircraftId = flight.aircraftId;
         slot.startTime = flight.departureTime;
         slot.location = flight.getOrigin() + " → " + flight.getDestination();
-        // Calculate end time based on estimated time
-        slot.endTime = flight.departureTime; // Simplified
+
+        // Arrival: departure plus the estimated flight time
+        int64_t departure = TimeUtil::parseMinutes(flight.departureTime);
+        if (departure != TimeUtil::NO_TIME) {
+            slot.endTime = TimeUtil::formatMinutes(departure + flightMinutes(flight));
+        }
 
         slots.push_back(slot);
     }
@@ -1,9 +1,12 @@
 #ifndef SCHEDULING_H
 #define SCHEDULING_H
 #include "Flight.h"
+#include <cstdint>
 #include <vector>
 #include <string>
 
+class DataStore;
+
 /**
  * @brief Flight scheduling and conflict detection
  *
@@ -12,6 +15,21 @@
  * - Aircraft scheduling
  * - Gate assignments
  * - Conflict detection and resolution
+ *
+ * Why time windows?
+ * - A flight occupies its aircraft from departure until arrival
+ *   (departure + estimatedTime) plus TURNAROUND_MINUTES on the ground.
+ *   Two SCHEDULED flights conflict only if they share an aircraft and
+ *   their windows overlap; back-to-back windows do not conflict
+ * - Departure times are parsed once per check into epoch minutes
+ *   (TimeUtil); a flight whose time does not parse has no window and
+ *   conflicts with nothing
+ *
+ * Why a sweep?
+ * - detectConflicts() compared every pair of flights: O(n^2) even when
+ *   nothing overlapped. It now sorts each aircraft's windows by start
+ *   and sweeps them, keeping only the windows still open: O(n log n)
+ *   plus the number of conflicts reported
  */
 class Scheduling {
 public:
@@ -22,21 +40,44 @@ public:
         std::string location;
     };
 
+    // Ground time after arrival before the aircraft can depart again
+    static constexpr int TURNAROUND_MINUTES = 45;
+
+    /**
+     * Minutes [start, end) the flight occupies its aircraft, turnaround
+     * included
+     * @return false if the departure time does not parse
+     */
+    static bool getTimeWindow(const Flight& flight, int64_t& start, int64_t& end);
+
     /**
      * Check if a flight can be scheduled without conflicts
+     * (false if the flight itself has no valid departure time)
      */
     static bool canSchedule(const Flight& flight,
                             const std::vector<Flight>& existingFlights);
 
+    /**
+     * Same check against the store's live schedule
+     * (DataStore::findScheduleConflicts): O(log n + k) for k conflicts
+     */
+    static bool canSchedule(const Flight& flight, const DataStore& store);
+
     /**
      * Detect scheduling conflicts
-     * @return Vector of conflicting flight pairs
+     * @return Vector of conflicting flight pairs, the earlier departure
+     *         first, grouped by aircraft id
      */
     static std::vector<std::pair<std::string, std::string>>
     detectConflicts(const std::vector<Flight>& flights);
 
+    // Same over the store's flights, without copying them
+    static std::vector<std::pair<std::string, std::string>>
+    detectConflicts(const DataStore& store);
+
     /**
      * Generate Gantt chart data for visualization
+     * (endTime is the arrival; empty if the departure does not parse)
      */
     static std::vector<TimeSlot> generateGanttData(
         const std::vector<Flight>& flights);
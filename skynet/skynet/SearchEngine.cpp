@@ -0,0 +1,409 @@
+#include "SearchEngine.h"
+#include "Haversine.h"
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+SearchEngine::SearchEngine()
+    : meetingNode(CompactGraph::INVALID_NODE), generation(0), settledCount(0) {}
+
+void SearchEngine::prepare(const CompactGraph& graph) {
+    const size_t nodeCount = graph.getNodeCount();
+
+    // Grow only; new slots start with stamp 0, which is never current
+    if (stamp.size() < nodeCount) {
+        dist.resize(nodeCount);
+        cost.resize(nodeCount);
+        parent.resize(nodeCount);
+        stamp.resize(nodeCount, 0);
+        settledStamp.resize(nodeCount, 0);
+        hValue.resize(nodeCount);
+        hStamp.resize(nodeCount, 0);
+        distBack.resize(nodeCount);
+        costBack.resize(nodeCount);
+        parentBack.resize(nodeCount);
+        stampBack.resize(nodeCount, 0);
+        settledStampBack.resize(nodeCount, 0);
+    }
+
+    // On wrap-around, stale stamps could alias the new generation
+    if (++generation == 0) {
+        std::fill(stamp.begin(), stamp.end(), 0);
+        std::fill(settledStamp.begin(), settledStamp.end(), 0);
+        std::fill(hStamp.begin(), hStamp.end(), 0);
+        std::fill(stampBack.begin(), stampBack.end(), 0);
+        std::fill(settledStampBack.begin(), settledStampBack.end(), 0);
+        generation = 1;
+    }
+
+    settledCount = 0;
+    meetingNode = CompactGraph::INVALID_NODE;
+    heap.clear();
+    heapBack.clear();
+}
+
+double SearchEngine::getDistance(NodeId v) const {
+    return isReached(v) ? dist[v] : std::numeric_limits<double>::infinity();
+}
+
+double SearchEngine::getCost(NodeId v) const {
+    return isReached(v) ? cost[v] : 0.0;
+}
+
+SearchEngine::NodeId SearchEngine::getParent(NodeId v) const {
+    return isReached(v) ? parent[v] : CompactGraph::INVALID_NODE;
+}
+
+bool SearchEngine::search(const CompactGraph& graph, NodeId source, NodeId target,
+                          Metric metric) {
+    prepare(graph);
+
+    dist[source] = 0.0;
+    cost[source] = 0.0;
+    parent[source] = CompactGraph::INVALID_NODE;
+    stamp[source] = generation;
+
+    // Minimize one array; the other is carried along the chosen path
+    const bool byCost = (metric == Metric::COST);
+    std::vector<double>& key = byCost ? cost : dist;
+    std::vector<double>& carried = byCost ? dist : cost;
+
+    heap.push_back({0.0, source});
+
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<HeapEntry>());
+        HeapEntry top = heap.back();
+        heap.pop_back();
+
+        NodeId current = top.node;
+
+        // Skip stale heap entries (lazy deletion)
+        if (settledStamp[current] == generation) {
+            continue;
+        }
+        settledStamp[current] = generation;
+        ++settledCount;
+
+        if (current == target) {
+            return true;
+        }
+
+        const double currentKey = key[current];
+        for (uint32_t e = graph.edgeBegin(current); e < graph.edgeEnd(current); ++e) {
+            NodeId neighbor = graph.edgeTarget(e);
+            double newKey = currentKey + (byCost ? graph.edgeCost(e) : graph.edgeWeight(e));
+
+            // Untouched slots count as infinity
+            if (stamp[neighbor] != generation || newKey < key[neighbor]) {
+                key[neighbor] = newKey;
+                carried[neighbor] = carried[current] +
+                    (byCost ? graph.edgeWeight(e) : graph.edgeCost(e));
+                parent[neighbor] = current;
+                stamp[neighbor] = generation;
+
+                heap.push_back({newKey, neighbor});
+                std::push_heap(heap.begin(), heap.end(), std::greater<HeapEntry>());
+            }
+        }
+    }
+
+    return target == CompactGraph::INVALID_NODE;
+}
+
+double SearchEngine::heuristic(const CompactGraph& graph, NodeId v, NodeId target) {
+    if (hStamp[v] == generation) {
+        return hValue[v];
+    }
+
+    double h = 0.0;
+    if (graph.hasCoordinates(v) && graph.hasCoordinates(target)) {
+        h = Haversine::calculate(graph.getLatitude(v), graph.getLongitude(v),
+                                 graph.getLatitude(target), graph.getLongitude(target));
+    }
+
+    hValue[v] = h;
+    hStamp[v] = generation;
+    return h;
+}
+
+bool SearchEngine::searchAStar(const CompactGraph& graph, NodeId source, NodeId target) {
+    prepare(graph);
+
+    dist[source] = 0.0;
+    cost[source] = 0.0;
+    parent[source] = CompactGraph::INVALID_NODE;
+    stamp[source] = generation;
+
+    // Heap key is f = g + h
+    heap.push_back({heuristic(graph, source, target), source});
+
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<HeapEntry>());
+        HeapEntry top = heap.back();
+        heap.pop_back();
+
+        NodeId current = top.node;
+        const double currentDist = dist[current];
+
+        // Stale if a shorter path to current was pushed after this entry
+        if (top.key > currentDist + heuristic(graph, current, target)) {
+            continue;
+        }
+        settledStamp[current] = generation;
+        ++settledCount;
+
+        if (current == target) {
+            return true;
+        }
+
+        for (uint32_t e = graph.edgeBegin(current); e < graph.edgeEnd(current); ++e) {
+            NodeId neighbor = graph.edgeTarget(e);
+            double newDist = currentDist + graph.edgeWeight(e);
+
+            if (stamp[neighbor] != generation || newDist < dist[neighbor]) {
+                dist[neighbor] = newDist;
+                cost[neighbor] = cost[current] + graph.edgeCost(e);
+                parent[neighbor] = current;
+                stamp[neighbor] = generation;
+
+                heap.push_back({newDist + heuristic(graph, neighbor, target), neighbor});
+                std::push_heap(heap.begin(), heap.end(), std::greater<HeapEntry>());
+            }
+        }
+    }
+
+    return false;
+}
+
+bool SearchEngine::searchBidirectional(const CompactGraph& graph,
+                                       NodeId source, NodeId target) {
+    prepare(graph);
+
+    const double INF = std::numeric_limits<double>::infinity();
+    double best = INF;  // mu: shortest s-t path seen so far
+
+    dist[source] = 0.0;
+    cost[source] = 0.0;
+    parent[source] = CompactGraph::INVALID_NODE;
+    stamp[source] = generation;
+    heap.push_back({0.0, source});
+
+    distBack[target] = 0.0;
+    costBack[target] = 0.0;
+    parentBack[target] = CompactGraph::INVALID_NODE;
+    stampBack[target] = generation;
+    heapBack.push_back({0.0, target});
+
+    bool forwardTurn = true;
+    while (!heap.empty() && !heapBack.empty()) {
+        // Meeting criterion: no unsettled path can beat mu any more
+        if (heap.front().key + heapBack.front().key >= best) {
+            break;
+        }
+
+        if (forwardTurn) {
+            std::pop_heap(heap.begin(), heap.end(), std::greater<HeapEntry>());
+            NodeId current = heap.back().node;
+            heap.pop_back();
+
+            if (settledStamp[current] != generation) {
+                settledStamp[current] = generation;
+                ++settledCount;
+
+                const double currentDist = dist[current];
+                for (uint32_t e = graph.edgeBegin(current); e < graph.edgeEnd(current); ++e) {
+                    NodeId neighbor = graph.edgeTarget(e);
+                    double newDist = currentDist + graph.edgeWeight(e);
+
+                    if (stamp[neighbor] != generation || newDist < dist[neighbor]) {
+                        dist[neighbor] = newDist;
+                        cost[neighbor] = cost[current] + graph.edgeCost(e);
+                        parent[neighbor] = current;
+                        stamp[neighbor] = generation;
+                        heap.push_back({newDist, neighbor});
+                        std::push_heap(heap.begin(), heap.end(), std::greater<HeapEntry>());
+
+                        if (stampBack[neighbor] == generation &&
+                            newDist + distBack[neighbor] < best) {
+                            best = newDist + distBack[neighbor];
+                            meetingNode = neighbor;
+                        }
+                    }
+                }
+            }
+        } else {
+            std::pop_heap(heapBack.begin(), heapBack.end(), std::greater<HeapEntry>());
+            NodeId current = heapBack.back().node;
+            heapBack.pop_back();
+
+            if (settledStampBack[current] != generation) {
+                settledStampBack[current] = generation;
+                ++settledCount;
+
+                const double currentDist = distBack[current];
+                for (uint32_t e = graph.reverseEdgeBegin(current);
+                     e < graph.reverseEdgeEnd(current); ++e) {
+                    NodeId neighbor = graph.reverseEdgeSource(e);
+                    double newDist = currentDist + graph.reverseEdgeWeight(e);
+
+                    if (stampBack[neighbor] != generation || newDist < distBack[neighbor]) {
+                        distBack[neighbor] = newDist;
+                        costBack[neighbor] = costBack[current] + graph.reverseEdgeCost(e);
+                        parentBack[neighbor] = current;
+                        stampBack[neighbor] = generation;
+                        heapBack.push_back({newDist, neighbor});
+                        std::push_heap(heapBack.begin(), heapBack.end(), std::greater<HeapEntry>());
+
+                        if (stamp[neighbor] == generation &&
+                            newDist + dist[neighbor] < best) {
+                            best = newDist + dist[neighbor];
+                            meetingNode = neighbor;
+                        }
+                    }
+                }
+            }
+        }
+
+        forwardTurn = !forwardTurn;
+    }
+
+    return meetingNode != CompactGraph::INVALID_NODE;
+}
+
+PathResult SearchEngine::findShortestPath(const CompactGraph& graph,
+                                          const std::string& start,
+                                          const std::string& end) {
+    return runQuery(graph, start, end, Mode::DIJKSTRA);
+}
+
+PathResult SearchEngine::findCheapestPath(const CompactGraph& graph,
+                                          const std::string& start,
+                                          const std::string& end) {
+    return runQuery(graph, start, end, Mode::CHEAPEST);
+}
+
+PathResult SearchEngine::findShortestPathAStar(const CompactGraph& graph,
+                                               const std::string& start,
+                                               const std::string& end) {
+    return runQuery(graph, start, end, Mode::ASTAR);
+}
+
+PathResult SearchEngine::findShortestPathBidirectional(const CompactGraph& graph,
+                                                       const std::string& start,
+                                                       const std::string& end) {
+    return runQuery(graph, start, end, Mode::BIDIRECTIONAL);
+}
+
+PathResult SearchEngine::runQuery(const CompactGraph& graph,
+                                  const std::string& start,
+                                  const std::string& end,
+                                  Mode mode) {
+    NodeId source = graph.getNodeId(start);
+    NodeId target = graph.getNodeId(end);
+
+    // Validate inputs
+    if (source == CompactGraph::INVALID_NODE) {
+        PathResult result;
+        result.found = false;
+        result.errorMessage = "Origin airport not found";
+        return result;
+    }
+
+    if (target == CompactGraph::INVALID_NODE) {
+        PathResult result;
+        result.found = false;
+        result.errorMessage = "Destination airport not found";
+        return result;
+    }
+
+    if (source == target) {
+        PathResult result;
+        result.found = true;
+        result.path = {start};
+        result.totalDistance = 0.0;
+        result.totalCost = 0.0;
+        return result;
+    }
+
+    bool reached = false;
+    switch (mode) {
+    case Mode::DIJKSTRA:
+        reached = search(graph, source, target);
+        break;
+    case Mode::CHEAPEST:
+        reached = search(graph, source, target, Metric::COST);
+        break;
+    case Mode::ASTAR:
+        reached = searchAStar(graph, source, target);
+        break;
+    case Mode::BIDIRECTIONAL:
+        reached = searchBidirectional(graph, source, target);
+        break;
+    }
+    if (!reached) {
+        PathResult result;
+        result.found = false;
+        result.errorMessage = "No route available between airports";
+        result.nodesExpanded = static_cast<int>(settledCount);
+        return result;
+    }
+
+    if (mode == Mode::BIDIRECTIONAL) {
+        return buildBidirectionalResult(graph, source, target);
+    }
+    return buildResult(graph, source, target);
+}
+
+PathResult SearchEngine::buildResult(const CompactGraph& graph,
+                                     NodeId source,
+                                     NodeId target) {
+    // Backtrack from destination to source
+    pathScratch.clear();
+    for (NodeId v = target; v != CompactGraph::INVALID_NODE; v = parent[v]) {
+        pathScratch.push_back(v);
+        if (v == source) break;
+    }
+
+    PathResult result;
+    result.found = true;
+    result.path.reserve(pathScratch.size());
+    for (auto it = pathScratch.rbegin(); it != pathScratch.rend(); ++it) {
+        result.path.push_back(graph.getNodeCode(*it));
+    }
+    result.totalDistance = dist[target];
+    result.totalCost = cost[target];
+    result.nodesExpanded = static_cast<int>(settledCount);
+
+    return result;
+}
+
+PathResult SearchEngine::buildBidirectionalResult(const CompactGraph& graph,
+                                                  NodeId source,
+                                                  NodeId target) {
+    // Forward half: meeting node back to source
+    pathScratch.clear();
+    for (NodeId v = meetingNode; v != CompactGraph::INVALID_NODE; v = parent[v]) {
+        pathScratch.push_back(v);
+        if (v == source) break;
+    }
+    std::reverse(pathScratch.begin(), pathScratch.end());
+
+    // Backward half: meeting node forward to target
+    for (NodeId v = parentBack[meetingNode]; v != CompactGraph::INVALID_NODE;
+         v = parentBack[v]) {
+        pathScratch.push_back(v);
+        if (v == target) break;
+    }
+
+    PathResult result;
+    result.found = true;
+    result.path.reserve(pathScratch.size());
+    for (NodeId v : pathScratch) {
+        result.path.push_back(graph.getNodeCode(v));
+    }
+    result.totalDistance = dist[meetingNode] + distBack[meetingNode];
+    result.totalCost = cost[meetingNode] + costBack[meetingNode];
+    result.nodesExpanded = static_cast<int>(settledCount);
+
+    return result;
+}
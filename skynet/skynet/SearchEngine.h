@@ -0,0 +1,171 @@
+#ifndef SEARCHENGINE_H
+#define SEARCHENGINE_H
+#include "CompactGraph.h"
+#include "PathResult.h"
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Reusable Dijkstra search over a CompactGraph
+ *
+ * Why a stateful engine instead of a static function?
+ * - Dijkstra::findShortestPath allocates its distance/parent/visited
+ *   containers on every call and initializes them for every node
+ * - The engine owns dense arrays indexed by node id and keeps them
+ *   (and the heap's capacity) between queries
+ *
+ * Why a generation counter?
+ * - Each slot carries the generation that last wrote it; a slot whose
+ *   stamp differs from the current generation reads as "untouched"
+ * - Starting a new query is just ++generation: no clearing pass, so
+ *   reset cost is O(touched) rather than O(V)
+ *
+ * After warm-up, repeated queries on the same graph make no heap
+ * allocations inside the search (only the returned PathResult allocates).
+ *
+ * A* mode:
+ * - Uses the great-circle (Haversine) distance to the destination as
+ *   heuristic; admissible because no route is shorter than the
+ *   great-circle distance between its airports
+ * - Needs coordinates on the CompactGraph (DataStore attaches them);
+ *   nodes without coordinates get h = 0, which stays admissible
+ * - Settled nodes may be reopened if a shorter path turns up, so the
+ *   result is optimal even where the heuristic is not consistent
+ *
+ * Bidirectional mode:
+ * - Alternates a forward search from the origin with a backward search
+ *   (over the reverse CSR) from the destination
+ * - Tracks the best meeting distance mu and stops once the two frontier
+ *   minimums sum to at least mu; each side covers roughly half the
+ *   radius, so about half the nodes are settled on long queries
+ *
+ * Not thread-safe: use one engine per thread.
+ */
+class SearchEngine {
+public:
+    using NodeId = CompactGraph::NodeId;
+
+    // Edge value a search minimizes
+    enum class Metric { DISTANCE, COST };
+
+    SearchEngine();
+
+    /**
+     * Find shortest path between two airports
+     * @param graph Compact flight network graph
+     * @param start Origin airport code
+     * @param end Destination airport code
+     * @return PathResult with complete path information
+     */
+    PathResult findShortestPath(const CompactGraph& graph,
+                                const std::string& start,
+                                const std::string& end);
+
+    /**
+     * Find the lowest operational-cost path (distance is carried along)
+     */
+    PathResult findCheapestPath(const CompactGraph& graph,
+                                const std::string& start,
+                                const std::string& end);
+
+    /**
+     * Run Dijkstra from source until target is settled
+     * @param target CompactGraph::INVALID_NODE searches the whole component
+     * @param metric Edge value to minimize (the other is accumulated)
+     * @return true if target was reached (always true for full searches)
+     */
+    bool search(const CompactGraph& graph, NodeId source, NodeId target,
+                Metric metric = Metric::DISTANCE);
+
+    /**
+     * A* variant of findShortestPath guided by great-circle distance
+     * @return Same PathResult as Dijkstra (nodesExpanded shows the savings)
+     */
+    PathResult findShortestPathAStar(const CompactGraph& graph,
+                                     const std::string& start,
+                                     const std::string& end);
+
+    /**
+     * Run A* from source until target is settled
+     * @return true if target was reached
+     */
+    bool searchAStar(const CompactGraph& graph, NodeId source, NodeId target);
+
+    /**
+     * Bidirectional Dijkstra variant of findShortestPath
+     * @return Same distance and cost as findShortestPath; on equal-length
+     *         ties the chosen path may differ
+     */
+    PathResult findShortestPathBidirectional(const CompactGraph& graph,
+                                             const std::string& start,
+                                             const std::string& end);
+
+    /**
+     * Run bidirectional Dijkstra between source and target
+     * @return true if the searches met
+     */
+    bool searchBidirectional(const CompactGraph& graph, NodeId source, NodeId target);
+
+    // Results of the last search (valid until the next one)
+    bool isReached(NodeId v) const { return stamp[v] == generation; }
+    double getDistance(NodeId v) const;
+    double getCost(NodeId v) const;
+    NodeId getParent(NodeId v) const;
+    uint32_t getSettledCount() const { return settledCount; }
+
+private:
+    struct HeapEntry {
+        double key;
+        NodeId node;
+        bool operator>(const HeapEntry& other) const { return key > other.key; }
+    };
+
+    enum class Mode { DIJKSTRA, CHEAPEST, ASTAR, BIDIRECTIONAL };
+
+    // Size arrays for the graph and start a fresh generation
+    void prepare(const CompactGraph& graph);
+
+    // Validate endpoints, run the search in the given mode, build result
+    PathResult runQuery(const CompactGraph& graph,
+                        const std::string& start,
+                        const std::string& end,
+                        Mode mode);
+
+    // Great-circle distance from v to target, cached per generation
+    double heuristic(const CompactGraph& graph, NodeId v, NodeId target);
+
+    // Build PathResult by walking parent ids from target
+    PathResult buildResult(const CompactGraph& graph, NodeId source, NodeId target);
+
+    // Build PathResult from both half-paths joined at meetingNode
+    PathResult buildBidirectionalResult(const CompactGraph& graph,
+                                        NodeId source, NodeId target);
+
+    // Per-node state, valid only where stamp[v] == generation
+    std::vector<double> dist;
+    std::vector<double> cost;
+    std::vector<NodeId> parent;
+    std::vector<uint32_t> stamp;
+    std::vector<uint32_t> settledStamp;
+    std::vector<double> hValue;
+    std::vector<uint32_t> hStamp;
+
+    // Backward search state (parent = next hop toward the target)
+    std::vector<double> distBack;
+    std::vector<double> costBack;
+    std::vector<NodeId> parentBack;
+    std::vector<uint32_t> stampBack;
+    std::vector<uint32_t> settledStampBack;
+    NodeId meetingNode;
+    uint32_t generation;
+    uint32_t settledCount;
+
+    // Scratch buffers reused across queries
+    std::vector<HeapEntry> heap;
+    std::vector<HeapEntry> heapBack;
+    std::vector<NodeId> pathScratch;
+};
+
+#endif // SEARCHENGINE_H
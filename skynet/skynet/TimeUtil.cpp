@@ -0,0 +1,101 @@
+#include "TimeUtil.h"
+#include <cstdio>
+
+namespace {
+
+// Read exactly `width` digits at text[pos]
+bool readNumber(std::string_view text, size_t pos, size_t width, int& value) {
+    if (pos + width > text.size()) {
+        return false;
+    }
+    value = 0;
+    for (size_t i = pos; i < pos + width; ++i) {
+        if (text[i] < '0' || text[i] > '9') {
+            return false;
+        }
+        value = value * 10 + (text[i] - '0');
+    }
+    return true;
+}
+
+bool isLeapYear(int year) {
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+int daysInMonth(int year, int month) {
+    static const int DAYS[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    return (month == 2 && isLeapYear(year)) ? 29 : DAYS[month - 1];
+}
+
+// Days since 1970-01-01 for a proleptic Gregorian date (H. Hinnant's
+// days_from_civil)
+int64_t daysFromCivil(int year, int month, int day) {
+    year -= month <= 2;
+    const int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const int64_t yearOfEra = year - era * 400;
+    const int64_t dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+void civilFromDays(int64_t days, int& year, int& month, int& day) {
+    days += 719468;
+    const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const int64_t dayOfEra = days - era * 146097;
+    const int64_t yearOfEra =
+        (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    const int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    const int64_t shiftedMonth = (5 * dayOfYear + 2) / 153;
+    day = static_cast<int>(dayOfYear - (153 * shiftedMonth + 2) / 5 + 1);
+    month = static_cast<int>(shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9);
+    year = static_cast<int>(yearOfEra + era * 400 + (month <= 2));
+}
+
+} // namespace
+
+int64_t TimeUtil::parseMinutes(std::string_view text) {
+    // yyyy-MM-ddTHH:mm[:ss]
+    // 0    5  8  11 14 17
+    if (text.size() != 16 && text.size() != 19) {
+        return NO_TIME;
+    }
+    int year, month, day, hour, minute, second = 0;
+    if (!readNumber(text, 0, 4, year) || text[4] != '-' ||
+        !readNumber(text, 5, 2, month) || text[7] != '-' ||
+        !readNumber(text, 8, 2, day) || (text[10] != 'T' && text[10] != ' ') ||
+        !readNumber(text, 11, 2, hour) || text[13] != ':' ||
+        !readNumber(text, 14, 2, minute)) {
+        return NO_TIME;
+    }
+    if (text.size() == 19 && (text[16] != ':' || !readNumber(text, 17, 2, second))) {
+        return NO_TIME;
+    }
+    if (month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month) ||
+        hour > 23 || minute > 59 || second > 59) {
+        return NO_TIME;
+    }
+
+    return daysFromCivil(year, month, day) * 1440 + hour * 60 + minute;
+}
+
+std::string TimeUtil::formatMinutes(int64_t minutes) {
+    if (minutes == NO_TIME) {
+        return std::string();
+    }
+
+    // Floor division, so times before 1970 still format correctly
+    int64_t days = minutes / 1440;
+    int64_t minuteOfDay = minutes % 1440;
+    if (minuteOfDay < 0) {
+        minuteOfDay += 1440;
+        --days;
+    }
+
+    int year, month, day;
+    civilFromDays(days, year, month, day);
+
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%04d-%02d-%02dT%02d:%02d", year, month, day,
+                  static_cast<int>(minuteOfDay / 60), static_cast<int>(minuteOfDay % 60));
+    return buffer;
+}
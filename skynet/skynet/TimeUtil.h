@@ -0,0 +1,38 @@
+#ifndef TIMEUTIL_H
+#define TIMEUTIL_H
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Flight times as integer minutes since 1970-01-01 00:00
+ *
+ * Why minutes?
+ * - Flight::departureTime is text ("2025-01-15T10:00", or with ":ss"
+ *   when booked from the UI). Comparing and subtracting text times
+ *   needs parsing every time; parsed once into an integer, ordering and
+ *   overlap checks are plain integer arithmetic
+ * - Schedules are planned to the minute; seconds are dropped
+ *
+ * Times carry no time zone: all departure times are taken to be in the
+ * same one.
+ */
+class TimeUtil {
+public:
+    // Stands in for a time that did not parse; sorts before all others
+    static constexpr int64_t NO_TIME = std::numeric_limits<int64_t>::min();
+    static constexpr int64_t MAX_TIME = std::numeric_limits<int64_t>::max();
+
+    /**
+     * Parse "yyyy-MM-ddTHH:mm" or "yyyy-MM-ddTHH:mm:ss" (a space may
+     * replace the 'T')
+     * @return Minutes since the epoch, or NO_TIME if the text is malformed
+     */
+    static int64_t parseMinutes(std::string_view text);
+
+    // Format as "yyyy-MM-ddTHH:mm" (the inverse of parseMinutes)
+    static std::string formatMinutes(int64_t minutes);
+};
+
+#endif // TIMEUTIL_H
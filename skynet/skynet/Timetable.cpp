@@ -0,0 +1,130 @@
+#include "Timetable.h"
+#include "Haversine.h"
+#include "TimeUtil.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+Timetable Timetable::build(const std::vector<Flight>& flights,
+                           const EntityTable<Airport>* airports) {
+    std::vector<const Flight*> pointers;
+    pointers.reserve(flights.size());
+    for (const Flight& flight : flights) {
+        pointers.push_back(&flight);
+    }
+    return build(pointers, airports);
+}
+
+Timetable Timetable::build(const std::vector<const Flight*>& flights,
+                           const EntityTable<Airport>* airports) {
+    Timetable timetable;
+
+    // Flights that can be timed, with their parsed departure
+    std::vector<std::pair<const Flight*, int64_t>> timed;
+    timed.reserve(flights.size());
+    int64_t base = TimeUtil::MAX_TIME;
+    for (const Flight* flight : flights) {
+        if (flight->status != "SCHEDULED" || flight->route.size() < 2 ||
+            !(flight->estimatedTime > 0.0)) {
+            continue;
+        }
+        int64_t departure = TimeUtil::parseMinutes(flight->departureTime);
+        if (departure != TimeUtil::NO_TIME) {
+            timed.emplace_back(flight, departure);
+            base = std::min(base, departure);
+        }
+    }
+    if (timed.empty()) {
+        return timetable;
+    }
+    timetable.baseTime = base;
+
+    const int64_t latest = std::numeric_limits<int32_t>::max();
+    std::vector<double> legLengths;
+    for (const auto& [flight, departure] : timed) {
+        const std::vector<std::string>& route = flight->route;
+        const size_t legCount = route.size() - 1;
+
+        // Weight each leg by its great-circle length when every airport
+        // is known, otherwise evenly
+        legLengths.assign(legCount, 1.0);
+        if (airports) {
+            for (size_t leg = 0; leg < legCount; ++leg) {
+                auto from = airports->find(route[leg]);
+                auto to = airports->find(route[leg + 1]);
+                if (from == airports->end() || to == airports->end()) {
+                    legLengths.assign(legCount, 1.0);
+                    break;
+                }
+                legLengths[leg] = Haversine::calculate(from->second.latitude, from->second.longitude,
+                                                       to->second.latitude, to->second.longitude);
+            }
+        }
+        double total = 0.0;
+        for (double length : legLengths) total += length;
+        if (!(total > 0.0)) {
+            legLengths.assign(legCount, 1.0);
+            total = static_cast<double>(legCount);
+        }
+
+        const double flightMinutes = flight->estimatedTime * 60.0;
+        const int64_t start = departure - base;
+        const int64_t end = start + static_cast<int64_t>(std::llround(flightMinutes));
+        if (end > latest) {
+            continue;
+        }
+
+        const uint32_t trip = static_cast<uint32_t>(timetable.tripFlights.size());
+        timetable.tripFlights.push_back(flight->flightNumber);
+
+        // Leg boundaries are rounded from the cumulative share, so the
+        // legs add up to the whole flight
+        double flown = 0.0;
+        int64_t legStart = start;
+        for (size_t leg = 0; leg < legCount; ++leg) {
+            flown += legLengths[leg];
+            int64_t legEnd = (leg + 1 == legCount)
+                                 ? end
+                                 : start + static_cast<int64_t>(std::llround(flightMinutes * flown / total));
+            Connection connection;
+            connection.departure = static_cast<int32_t>(legStart);
+            connection.arrival = static_cast<int32_t>(legEnd);
+            connection.from = timetable.internStop(route[leg]);
+            connection.to = timetable.internStop(route[leg + 1]);
+            connection.trip = trip;
+            timetable.connections.push_back(connection);
+            legStart = legEnd;
+        }
+    }
+
+    // Departure order; a trip's legs stay in flying order on ties
+    std::sort(timetable.connections.begin(), timetable.connections.end(),
+              [](const Connection& a, const Connection& b) {
+                  if (a.departure != b.departure) return a.departure < b.departure;
+                  if (a.arrival != b.arrival) return a.arrival < b.arrival;
+                  return a.trip < b.trip;
+              });
+    return timetable;
+}
+
+size_t Timetable::findFirstDeparture(int64_t minutes) const {
+    const int64_t relative = minutes - baseTime;
+    auto first = std::lower_bound(connections.begin(), connections.end(), relative,
+                                  [](const Connection& connection, int64_t value) {
+                                      return connection.departure < value;
+                                  });
+    return static_cast<size_t>(first - connections.begin());
+}
+
+Timetable::StopId Timetable::getStopId(const std::string& code) const {
+    auto it = stopIds.find(code);
+    return it == stopIds.end() ? INVALID_STOP : it->second;
+}
+
+Timetable::StopId Timetable::internStop(const std::string& code) {
+    auto [it, inserted] = stopIds.try_emplace(code, static_cast<StopId>(stopCodes.size()));
+    if (inserted) {
+        stopCodes.push_back(code);
+    }
+    return it->second;
+}
@@ -0,0 +1,86 @@
+#ifndef TIMETABLE_H
+#define TIMETABLE_H
+#include "EntityTable.h"
+#include "Flight.h"
+#include "airports.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Scheduled flight legs as one departure-sorted connection array
+ *
+ * Why a connection array?
+ * - The route graph only knows which airports are linked, not when
+ *   anything flies. Each leg of a SCHEDULED flight becomes a connection
+ *   (from, to, departure, arrival, trip); sorted by departure they are
+ *   all ConnectionScan needs, read front to back
+ * - Airport codes are interned to dense StopIds and times are stored as
+ *   32-bit minutes after getBaseTime(), so a connection is 20 bytes and
+ *   a day's schedule scans out of cache
+ *
+ * Leg times:
+ * - A flight's estimatedTime is split across its legs in proportion to
+ *   their great-circle length (evenly when an airport's coordinates are
+ *   unknown); the aircraft continues from an intermediate stop as soon
+ *   as it lands there
+ * - Flights without a parseable departure or a positive estimatedTime
+ *   are left out, as are times more than ~4000 years after the base
+ *
+ * A trip is one flight; trip ids index getTripFlight().
+ *
+ * Immutable once built: rebuild after the schedule changes.
+ */
+class Timetable {
+public:
+    using StopId = uint32_t;
+    static constexpr StopId INVALID_STOP = UINT32_MAX;
+
+    struct Connection {
+        int32_t departure;   // Minutes after getBaseTime()
+        int32_t arrival;
+        StopId from;
+        StopId to;
+        uint32_t trip;
+    };
+
+    Timetable() : baseTime(0) {}
+
+    /**
+     * Build from the SCHEDULED flights in `flights`
+     * @param airports Coordinates for splitting multi-stop flight times
+     *        (nullptr: even split)
+     */
+    static Timetable build(const std::vector<const Flight*>& flights,
+                           const EntityTable<Airport>* airports = nullptr);
+    static Timetable build(const std::vector<Flight>& flights,
+                           const EntityTable<Airport>* airports = nullptr);
+
+    const std::vector<Connection>& getConnections() const { return connections; }
+
+    // First connection departing at or after `minutes` (epoch minutes)
+    size_t findFirstDeparture(int64_t minutes) const;
+
+    // Epoch minutes of a connection's relative time
+    int64_t getBaseTime() const { return baseTime; }
+    int64_t toEpochMinutes(int32_t minutes) const { return baseTime + minutes; }
+
+    StopId getStopId(const std::string& code) const;
+    const std::string& getStopCode(StopId id) const { return stopCodes[id]; }
+    size_t getStopCount() const { return stopCodes.size(); }
+
+    const std::string& getTripFlight(uint32_t trip) const { return tripFlights[trip]; }
+    size_t getTripCount() const { return tripFlights.size(); }
+
+private:
+    StopId internStop(const std::string& code);
+
+    std::vector<Connection> connections;
+    int64_t baseTime;
+    std::vector<std::string> stopCodes;
+    std::unordered_map<std::string, StopId> stopIds;
+    std::vector<std::string> tripFlights;
+};
+
+#endif // TIMETABLE_H
@@ -17,6 +17,7 @@
  * - Build flight network graph
  * - Show main window
  * - Enter Qt event loop
+ * - Compact the edit journal on exit
  */
 int main(int argc, char *argv[]) {
     // Create Qt application
@@ -41,10 +42,10 @@ int main(int argc, char *argv[]) {
         }
 
         // Print statistics
-        std::cout << "Airports loaded: " << dataStore.getAllAirports().size() << std::endl;
-        std::cout << "Aircraft loaded: " << dataStore.getAllAircraft().size() << std::endl;
-        std::cout << "Routes loaded: " << dataStore.getAllRoutes().size() << std::endl;
-        std::cout << "Flights loaded: " << dataStore.getAllFlights().size() << std::endl;
+        std::cout << "Airports loaded: " << dataStore.getAirportCount() << std::endl;
+        std::cout << "Aircraft loaded: " << dataStore.getAircraftCount() << std::endl;
+        std::cout << "Routes loaded: " << dataStore.getRouteCount() << std::endl;
+        std::cout << "Flights loaded: " << dataStore.getFlightCount() << std::endl;
         std::cout << "Graph nodes: " << dataStore.getGraph().getNodeCount() << std::endl;
         std::cout << "Graph edges: " << dataStore.getGraph().getEdgeCount() << std::endl;
 
@@ -56,7 +57,11 @@ int main(int argc, char *argv[]) {
         std::cout << "Ready for operations." << std::endl;
 
         // Enter Qt event loop
-        return app.exec();
+        int result = app.exec();
+
+        // Fold this session's journal into the data files
+        dataStore.compactJournal();
+        return result;
 
     } catch (const std::exception& e) {
         std::cerr << "Fatal error: " << e.what() << std::endl;
@@ -94,10 +94,10 @@ void MainWindow::loadData() {
 
     if (store.loadAll()) {
         // Get loaded data counts
-        int airportCount = store.getAllAirports().size();
-        int aircraftCount = store.getAllAircraft().size();
-        int routeCount = store.getAllRoutes().size();
-        int flightCount = store.getAllFlights().size();
+        int airportCount = static_cast<int>(store.getAirportCount());
+        int aircraftCount = static_cast<int>(store.getAircraftCount());
+        int routeCount = static_cast<int>(store.getRouteCount());
+        int flightCount = static_cast<int>(store.getFlightCount());
 
         // Show success message with counts
         QString message = QString("✓ Data loaded: %1 airports, %2 aircraft, %3 routes, %4 flights")
@@ -158,7 +158,17 @@ void MainWindow::loadData() {
 void MainWindow::onSaveData() {
     DataStore& store = DataStore::getInstance();
 
-    if (store.saveAll()) {
+    // Written on the persistence thread; the result is posted back here
+    statusBar()->showMessage("Saving data...");
+    store.saveAllAsync([this](bool success) {
+        QMetaObject::invokeMethod(this, [this, success]() {
+            onSaveFinished(success);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void MainWindow::onSaveFinished(bool success) {
+    if (success) {
         statusBar()->showMessage("Data saved successfully", 3000);
         QMessageBox::information(this, "Save Complete",
                                  "All data has been saved to disk.");
@@ -27,6 +27,7 @@ public:
 
 private slots:
     void onSaveData();
+    void onSaveFinished(bool success);
     void onUndo();
     void onAbout();
 
@@ -7,13 +7,38 @@
  */
 
 #include "Graph.h"
+#include "CompactGraph.h"
 #include "Dijkstra.h"
+#include "SearchEngine.h"
+#include "ContractionHierarchy.h"
+#include "DistanceMatrix.h"
+#include "MultiCriteriaOptimizer.h"
+#include "QueryExecutor.h"
+#include "CsvReader.h"
+#include "EntityTable.h"
+#include "BinaryStore.h"
+#include "Journal.h"
+#include "AtomicFileWriter.h"
+#include "PersistenceService.h"
 #include "Haversine.h"
+#include "TimeUtil.h"
+#include "Scheduling.h"
+#include "FleetAssignment.h"
+#include "ConnectionScan.h"
 #include "DataStore.h"
 #include <iostream>
 #include <cassert>
 #include <cmath>
 #include <chrono>
+#include <atomic>
+#include <thread>
+#include <set>
+#include <map>
+#include <functional>
+#include <tuple>
+#include <filesystem>
+#include <algorithm>
+#include <fstream>
 
 // Test helper
 void assertTrue(bool condition, const std::string& testName) {
@@ -67,6 +92,10 @@ void testGraph() {
     auto neighbors = g.getNeighbors("A");
     assertTrue(neighbors.size() == 2, "A has 2 neighbors");
 
+    EdgeRange view = g.neighbors("A");
+    assertTrue(view.size() == 2 && view[0].destination == "B", "Neighbor view reads stored edges");
+    assertTrue(g.neighbors("D").empty(), "Neighbor view of unknown node is empty");
+
     // Test node deletion
     g.removeNode("B");
     assertTrue(g.getNodeCount() == 2, "Node count after deletion");
@@ -112,6 +141,880 @@ void testDijkstra() {
     assertTrue(result3.path.size() == 1, "Path to same node has 1 element");
 }
 
+void testCompactGraph() {
+    std::cout << "\n=== Testing CompactGraph (CSR) ===" << std::endl;
+
+    Graph g;
+    g.addEdge("A", "B", 10.0, 100.0);
+    g.addEdge("A", "C", 35.0, 350.0);
+    g.addEdge("B", "D", 20.0, 200.0);
+    g.addEdge("D", "C", 5.0, 50.0);
+
+    CompactGraph cg(g);
+    assertTrue(cg.getNodeCount() == 4, "CSR node count matches graph");
+    assertTrue(cg.getEdgeCount() == 4, "CSR edge count matches graph");
+    assertTrue(cg.getNodeId("A") == 0 && cg.getNodeId("D") == 3, "Ids follow sorted code order");
+    assertTrue(cg.getNodeId("Z") == CompactGraph::INVALID_NODE, "Unknown code has no id");
+
+    CompactGraph::NodeId a = cg.getNodeId("A");
+    assertTrue(cg.edgeEnd(a) - cg.edgeBegin(a) == 2, "A has 2 outgoing CSR edges");
+
+    PathResult fromList = Dijkstra::findShortestPath(g, "A", "C");
+    PathResult fromCsr = Dijkstra::findShortestPath(cg, "A", "C");
+    assertTrue(fromCsr.found && fromCsr.totalDistance == fromList.totalDistance,
+               "CSR Dijkstra distance matches adjacency list");
+    assertTrue(fromCsr.path == fromList.path, "CSR Dijkstra path matches adjacency list");
+    assertTrue(fromCsr.totalCost == fromList.totalCost, "CSR Dijkstra cost matches adjacency list");
+    assertTrue(!Dijkstra::findShortestPath(cg, "C", "A").found, "CSR respects edge direction");
+}
+
+void testSearchEngine() {
+    std::cout << "\n=== Testing SearchEngine (reusable workspace) ===" << std::endl;
+
+    // Ring of 50 nodes with chords, so queries overlap in touched nodes
+    Graph g;
+    const int n = 50;
+    for (int i = 0; i < n; ++i) {
+        std::string a = "N" + std::to_string(i);
+        std::string b = "N" + std::to_string((i + 1) % n);
+        std::string c = "N" + std::to_string((i + 7) % n);
+        g.addEdge(a, b, 10.0 + i % 3, 1.0);
+        g.addEdge(b, a, 10.0 + i % 3, 1.0);
+        g.addEdge(a, c, 65.0, 5.0);
+    }
+    g.addNode("ISLAND");
+
+    CompactGraph cg(g);
+    SearchEngine engine;
+
+    bool allMatch = true;
+    for (int i = 0; i < n; i += 3) {
+        for (int j = 0; j < n; j += 5) {
+            std::string from = "N" + std::to_string(i);
+            std::string to = "N" + std::to_string(j);
+            PathResult expected = Dijkstra::findShortestPath(g, from, to);
+            PathResult actual = engine.findShortestPath(cg, from, to);
+            if (actual.found != expected.found ||
+                std::abs(actual.totalDistance - expected.totalDistance) > 1e-9) {
+                allMatch = false;
+            }
+        }
+    }
+    assertTrue(allMatch, "Reused engine matches Dijkstra on every query");
+
+    PathResult unreachable = engine.findShortestPath(cg, "N0", "ISLAND");
+    assertTrue(!unreachable.found, "Unreachable node reported after reuse");
+
+    PathResult again = engine.findShortestPath(cg, "N0", "N1");
+    assertTrue(again.found && again.path.size() == 2, "Workspace reset between queries");
+}
+
+void testAStar() {
+    std::cout << "\n=== Testing A* (great-circle heuristic) ===" << std::endl;
+
+    // 20x20 lat/lon grid; each leg is 5% longer than its great circle
+    const int side = 20;
+    auto code = [](int r, int c) { return "G" + std::to_string(r) + "_" + std::to_string(c); };
+    auto lat = [](int r) { return 10.0 + r; };
+    auto lon = [](int c) { return 20.0 + c; };
+
+    Graph g;
+    for (int r = 0; r < side; ++r) {
+        for (int c = 0; c < side; ++c) {
+            if (c + 1 < side) {
+                double d = 1.05 * Haversine::calculate(lat(r), lon(c), lat(r), lon(c + 1));
+                g.addEdge(code(r, c), code(r, c + 1), d, d);
+                g.addEdge(code(r, c + 1), code(r, c), d, d);
+            }
+            if (r + 1 < side) {
+                double d = 1.05 * Haversine::calculate(lat(r), lon(c), lat(r + 1), lon(c));
+                g.addEdge(code(r, c), code(r + 1, c), d, d);
+                g.addEdge(code(r + 1, c), code(r, c), d, d);
+            }
+        }
+    }
+
+    CompactGraph cg(g);
+    for (int r = 0; r < side; ++r) {
+        for (int c = 0; c < side; ++c) {
+            cg.setCoordinates(code(r, c), lat(r), lon(c));
+        }
+    }
+
+    SearchEngine engine;
+    PathResult plain = engine.findShortestPath(cg, code(10, 0), code(10, side - 1));
+    PathResult astar = engine.findShortestPathAStar(cg, code(10, 0), code(10, side - 1));
+
+    assertTrue(astar.found, "A* finds a route");
+    assertTrue(std::abs(astar.totalDistance - plain.totalDistance) < 1e-6,
+               "A* distance equals Dijkstra distance");
+    assertTrue(astar.nodesExpanded * 2 < plain.nodesExpanded,
+               "A* expands under half the nodes Dijkstra does");
+    std::cout << "  Expanded: Dijkstra " << plain.nodesExpanded
+              << ", A* " << astar.nodesExpanded << std::endl;
+}
+
+void testBidirectional() {
+    std::cout << "\n=== Testing Bidirectional Dijkstra ===" << std::endl;
+
+    // Ring with one-way chords exercises the reverse CSR
+    Graph ring;
+    const int n = 40;
+    for (int i = 0; i < n; ++i) {
+        std::string a = "R" + std::to_string(i);
+        std::string b = "R" + std::to_string((i + 1) % n);
+        ring.addEdge(a, b, 10.0 + i % 4, 2.0);
+        ring.addEdge(b, a, 12.0 + i % 3, 3.0);
+        ring.addEdge(a, "R" + std::to_string((i + 9) % n), 50.0 + i % 5, 7.0);
+    }
+    CompactGraph ringCsr(ring);
+    SearchEngine engine;
+
+    bool allMatch = true;
+    for (int i = 0; i < n; i += 3) {
+        for (int j = 0; j < n; j += 4) {
+            std::string from = "R" + std::to_string(i);
+            std::string to = "R" + std::to_string(j);
+            PathResult expected = engine.findShortestPath(ringCsr, from, to);
+            PathResult actual = engine.findShortestPathBidirectional(ringCsr, from, to);
+            if (actual.found != expected.found ||
+                std::abs(actual.totalDistance - expected.totalDistance) > 1e-9 ||
+                std::abs(actual.totalCost - expected.totalCost) > 1e-9 ||
+                actual.path.front() != from || actual.path.back() != to) {
+                allMatch = false;
+            }
+        }
+    }
+    assertTrue(allMatch, "Bidirectional matches Dijkstra distance, cost and endpoints");
+
+    // Long query across a symmetric grid
+    Graph grid;
+    const int side = 30;
+    auto code = [](int r, int c) { return "Q" + std::to_string(r) + "_" + std::to_string(c); };
+    for (int r = 0; r < side; ++r) {
+        for (int c = 0; c < side; ++c) {
+            if (c + 1 < side) {
+                grid.addEdge(code(r, c), code(r, c + 1), 100.0 + (r * 7 + c) % 5, 1.0);
+                grid.addEdge(code(r, c + 1), code(r, c), 100.0 + (r * 7 + c) % 5, 1.0);
+            }
+            if (r + 1 < side) {
+                grid.addEdge(code(r, c), code(r + 1, c), 100.0 + (r + c * 3) % 7, 1.0);
+                grid.addEdge(code(r + 1, c), code(r, c), 100.0 + (r + c * 3) % 7, 1.0);
+            }
+        }
+    }
+    CompactGraph gridCsr(grid);
+    PathResult plain = engine.findShortestPath(gridCsr, code(15, 0), code(15, side - 1));
+    PathResult both = engine.findShortestPathBidirectional(gridCsr, code(15, 0), code(15, side - 1));
+    assertTrue(std::abs(plain.totalDistance - both.totalDistance) < 1e-9,
+               "Bidirectional long-haul distance matches");
+    assertTrue(both.nodesExpanded < plain.nodesExpanded * 0.75,
+               "Bidirectional settles clearly fewer nodes");
+    std::cout << "  Settled: Dijkstra " << plain.nodesExpanded
+              << ", bidirectional " << both.nodesExpanded << std::endl;
+}
+
+void testContractionHierarchy() {
+    std::cout << "\n=== Testing Contraction Hierarchies ===" << std::endl;
+
+    // Pseudo-random sparse network with asymmetric weights
+    Graph g;
+    const int n = 300;
+    unsigned seed = 12345;
+    auto next = [&seed]() { seed = seed * 1103515245u + 12345u; return (seed >> 8) % 100000; };
+    for (int i = 0; i < n; ++i) {
+        g.addNode("C" + std::to_string(i));
+    }
+    for (int i = 0; i < n * 3; ++i) {
+        int a = next() % n;
+        int b = next() % n;
+        if (a == b) continue;
+        g.addEdge("C" + std::to_string(a), "C" + std::to_string(b),
+                  100.0 + next() % 5000 + next() / 100000.0, 1.0 + next() % 50);
+    }
+
+    auto compact = std::make_shared<const CompactGraph>(g);
+    ContractionHierarchy ch(compact);
+    CHQuery query;
+    SearchEngine engine;
+
+    bool allMatch = true;
+    bool pathsValid = true;
+    for (int i = 0; i < n; i += 17) {
+        for (int j = 0; j < n; j += 13) {
+            std::string from = "C" + std::to_string(i);
+            std::string to = "C" + std::to_string(j);
+            PathResult expected = engine.findShortestPath(*compact, from, to);
+            PathResult actual = query.findShortestPath(ch, from, to);
+
+            if (actual.found != expected.found ||
+                (actual.found && std::abs(actual.totalDistance - expected.totalDistance) > 1e-6)) {
+                allMatch = false;
+                continue;
+            }
+            if (!actual.found) continue;
+
+            // Unpacked path must be a real walk with the reported length
+            double length = 0.0;
+            for (size_t k = 0; k + 1 < actual.path.size(); ++k) {
+                bool edgeFound = false;
+                for (const Edge& edge : g.neighbors(actual.path[k])) {
+                    if (edge.destination == actual.path[k + 1]) {
+                        length += edge.weight;
+                        edgeFound = true;
+                    }
+                }
+                pathsValid &= edgeFound;
+            }
+            pathsValid &= std::abs(length - actual.totalDistance) < 1e-6;
+            pathsValid &= actual.path.front() == from && actual.path.back() == to;
+        }
+    }
+    assertTrue(allMatch, "CH distances match Dijkstra");
+    assertTrue(pathsValid, "CH paths unpack to original edges");
+    std::cout << "  Shortcuts added: " << ch.getShortcutCount() << std::endl;
+
+    // DataStore drops the hierarchy when the network changes
+    DataStore& store = DataStore::getInstance();
+    auto before = store.getContractionHierarchy();
+    store.addRoute(Route("CHA", "CHB", 100.0, 10.0, true));
+    auto after = store.getContractionHierarchy();
+    assertTrue(before != after, "Hierarchy rebuilt after route edit");
+    assertTrue(query.findShortestPath(*after, "CHA", "CHB").found, "Rebuilt hierarchy sees new route");
+    store.deleteRoute("CHA-CHB");
+}
+
+void testDistanceMatrix() {
+    std::cout << "\n=== Testing DistanceMatrix ===" << std::endl;
+
+    Graph g;
+    const int n = 60;
+    for (int i = 0; i < n; ++i) {
+        std::string a = "M" + std::to_string(i);
+        g.addEdge(a, "M" + std::to_string((i + 1) % n), 10.0 + i % 7, 1.0);
+        g.addEdge(a, "M" + std::to_string((i + 11) % n), 70.0 + i % 3, 4.0);
+    }
+    g.addNode("ALONE");
+    CompactGraph cg(g);
+
+    DistanceMatrix::Result table = DistanceMatrix::computeAllPairs(cg, 4);
+    assertTrue(table.sources.size() == cg.getNodeCount() &&
+               table.distances.size() == table.sources.size() * table.targets.size(),
+               "All-pairs table is dense N x N");
+
+    SearchEngine engine;
+    bool allMatch = true;
+    for (size_t i = 0; i < table.sources.size(); i += 7) {
+        for (size_t j = 0; j < table.targets.size(); j += 5) {
+            PathResult expected = engine.findShortestPath(cg, table.sources[i], table.targets[j]);
+            if (expected.found != table.isReachable(i, j)) {
+                allMatch = false;
+            } else if (expected.found &&
+                       (std::abs(expected.totalDistance - table.getDistance(i, j)) > 1e-9 ||
+                        static_cast<int>(expected.path.size()) - 1 != table.getHops(i, j))) {
+                allMatch = false;
+            }
+        }
+    }
+    assertTrue(allMatch, "Matrix rows match point-to-point searches");
+
+    DistanceMatrix::Result partial = DistanceMatrix::compute(cg, {"M0", "NOPE"}, {"M5", "ALONE"});
+    assertTrue(partial.isReachable(0, 0) && partial.getHops(0, 0) == 5, "One-to-many hop count");
+    assertTrue(!partial.isReachable(0, 1) && !partial.isReachable(1, 0), "Unknown/unreachable cells marked");
+}
+
+void testQueryExecutor() {
+    std::cout << "\n=== Testing QueryExecutor (worker pool) ===" << std::endl;
+
+    Graph g;
+    const int n = 80;
+    for (int i = 0; i < n; ++i) {
+        std::string a = "Q" + std::to_string(i);
+        // Short legs are expensive, long chords are cheap
+        g.addEdge(a, "Q" + std::to_string((i + 1) % n), 10.0, 5.0);
+        g.addEdge(a, "Q" + std::to_string((i + 9) % n), 95.0, 1.0);
+    }
+    auto cg = std::make_shared<const CompactGraph>(g);
+    auto ch = std::make_shared<const ContractionHierarchy>(cg);
+
+    std::vector<QueryExecutor::Query> queries;
+    for (int i = 0; i < 40; ++i) {
+        queries.emplace_back("Q" + std::to_string(i), "Q" + std::to_string((i * 37 + 5) % n),
+                             i % 2 ? QueryExecutor::Criterion::COST
+                                   : QueryExecutor::Criterion::DISTANCE);
+    }
+    queries.emplace_back("Q0", "NOPE");
+
+    QueryExecutor executor(4);
+    std::vector<PathResult> withHierarchy = executor.runBatch({cg, ch, nullptr}, queries);
+    std::vector<PathResult> graphOnly = executor.runBatch({cg, nullptr, nullptr}, queries);
+    auto snapshot = std::make_shared<const GraphSnapshot>(1, cg);
+    std::vector<PathResult> fromSnapshot = executor.runBatch({cg, nullptr, snapshot}, queries);
+
+    SearchEngine engine;
+    bool allMatch = true;
+    for (size_t i = 0; i + 1 < queries.size(); ++i) {
+        const auto& q = queries[i];
+        PathResult expected = q.criterion == QueryExecutor::Criterion::COST
+            ? engine.findCheapestPath(*cg, q.origin, q.destination)
+            : engine.findShortestPath(*cg, q.origin, q.destination);
+        for (const PathResult* r : {&withHierarchy[i], &graphOnly[i], &fromSnapshot[i]}) {
+            if (!r->found || std::abs(r->totalDistance - expected.totalDistance) > 1e-9 ||
+                std::abs(r->totalCost - expected.totalCost) > 1e-9) {
+                allMatch = false;
+            }
+        }
+    }
+    assertTrue(allMatch, "Batch results match single-threaded searches");
+    assertTrue(!withHierarchy.back().found, "Unknown airport reported in batch");
+    bool hierarchyBuilt = false;
+    for (int wait = 0; wait < 500 && !hierarchyBuilt; ++wait) {
+        hierarchyBuilt = snapshot->tryGetContractionHierarchy() != nullptr;
+        if (!hierarchyBuilt) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    assertTrue(hierarchyBuilt, "Snapshot's hierarchy is built in the background");
+    assertTrue(!GraphSnapshot(2, cg).tryGetContractionHierarchy(),
+               "tryGetContractionHierarchy does not build");
+
+    PathResult shortest = engine.findShortestPath(*cg, "Q0", "Q45");
+    PathResult cheapest = engine.findCheapestPath(*cg, "Q0", "Q45");
+    assertTrue(cheapest.totalCost < shortest.totalCost &&
+               cheapest.totalDistance > shortest.totalDistance,
+               "Cost criterion trades distance for cost");
+
+    std::promise<PathResult> delivered;
+    executor.submit({cg, ch, nullptr}, QueryExecutor::Query("Q3", "Q30"),
+                    [&delivered](const PathResult& result) { delivered.set_value(result); });
+    assertTrue(delivered.get_future().get().found, "Callback delivery");
+
+    QueryExecutor single(1);
+    single.submit({cg, ch, nullptr}, QueryExecutor::Query("Q3", "Q30"),
+                  [](const PathResult&) { throw std::runtime_error("callback failed"); });
+    assertTrue(single.submit({cg, ch, nullptr}, QueryExecutor::Query("Q3", "Q30")).get().found,
+               "Worker survives a throwing callback");
+}
+
+void testGraphSnapshot() {
+    std::cout << "\n=== Testing GraphSnapshot (versioned publishing) ===" << std::endl;
+
+    DataStore& store = DataStore::getInstance();
+    store.addAirport(Airport("SNA", "Snapshot A", "City", "Country", 10.0, 10.0));
+    store.addAirport(Airport("SNB", "Snapshot B", "City", "Country", 10.0, 11.0));
+
+    auto held = store.getGraphSnapshot();
+    int heldEdges = held->getGraph().getEdgeCount();
+    store.addRoute(Route("SNA", "SNB", 110.0, 20.0, true));
+    auto current = store.getGraphSnapshot();
+
+    assertTrue(current->getVersion() > held->getVersion(), "Rebuild publishes a newer version");
+    assertTrue(held->getGraph().getEdgeCount() == heldEdges &&
+               !held->getGraph().hasEdge("SNA", "SNB"),
+               "Held snapshot is unchanged by later edits");
+    assertTrue(current->getGraph().hasEdge("SNA", "SNB") &&
+               current->getCompactGraph()->hasNode("SNA"),
+               "New snapshot sees the edit");
+    assertTrue(current->getContractionHierarchy() == current->getContractionHierarchy(),
+               "Hierarchy built once per snapshot");
+
+    // Readers search whatever version they grabbed while the writer republishes
+    std::atomic<bool> done(false);
+    std::atomic<int> badReads(0);
+    std::thread reader([&]() {
+        SearchEngine engine;
+        while (!done) {
+            auto snapshot = store.getGraphSnapshot();
+            PathResult r = engine.findShortestPath(*snapshot->getCompactGraph(), "SNA", "SNB");
+            if (snapshot->getGraph().hasEdge("SNA", "SNB") != r.found) ++badReads;
+        }
+    });
+    for (int i = 0; i < 20; ++i) {
+        store.deleteRoute("SNA-SNB");
+        store.addRoute(Route("SNA", "SNB", 110.0, 20.0, true));
+    }
+    done = true;
+    reader.join();
+    assertTrue(badReads == 0, "Concurrent readers never see a partial graph");
+
+    store.deleteRoute("SNA-SNB");
+    store.deleteAirport("SNA");
+    store.deleteAirport("SNB");
+}
+
+void testIncrementalGraph() {
+    std::cout << "\n=== Testing incremental graph maintenance ===" << std::endl;
+
+    // Flatten a graph to (from, to, weight, cost); edge order may differ
+    auto edgeSet = [](const Graph& g) {
+        std::set<std::tuple<std::string, std::string, double, double>> edges;
+        for (const auto& node : g.getNodes()) {
+            for (const Edge& e : g.neighbors(node)) {
+                edges.emplace(node, e.destination, e.weight, e.cost);
+            }
+        }
+        return edges;
+    };
+
+    DataStore& store = DataStore::getInstance();
+    const int airportCount = 12;
+    for (int i = 0; i < airportCount; ++i) {
+        store.addAirport(Airport("IG" + std::to_string(i), "Inc", "City", "Country", i, i));
+    }
+
+    // Random edits, including reverse-direction duplicates, closed routes
+    // and a route to a code that is not an airport
+    unsigned seed = 12345;
+    auto next = [&seed]() { seed = seed * 1103515245u + 12345u; return (seed >> 16) & 0x7fff; };
+    for (int step = 0; step < 600; ++step) {
+        std::string a = "IG" + std::to_string(next() % airportCount);
+        std::string b = next() % 10 ? "IG" + std::to_string(next() % airportCount) : "IGX";
+        Route route(a, b, 100.0 + next() % 50, 10.0 + next() % 5, next() % 4 != 0);
+        switch (next() % 4) {
+        case 0: store.deleteRoute(route.getId()); break;
+        case 1: store.updateRoute(route); break;
+        default: store.addRoute(route); break;
+        }
+        if (step == 300) store.deleteAirport("IG3");
+        if (step == 400) store.addAirport(Airport("IG3", "Inc", "City", "Country", 3, 3));
+    }
+
+    auto incremental = store.getGraphSnapshot();
+    store.rebuildGraph();
+    auto rebuilt = store.getGraphSnapshot();
+
+    assertTrue(incremental->getGraph().getNodes() == rebuilt->getGraph().getNodes(),
+               "Incremental edits keep the same node set as a rebuild");
+    assertTrue(edgeSet(incremental->getGraph()) == edgeSet(rebuilt->getGraph()) &&
+               incremental->getGraph().getEdgeCount() == rebuilt->getGraph().getEdgeCount(),
+               "Incremental edits keep the same edges as a rebuild");
+
+    for (int i = 0; i < airportCount; ++i) {
+        store.deleteAirport("IG" + std::to_string(i));
+    }
+    assertTrue(!store.getGraph().hasNode("IGX") && !store.getGraph().hasNode("IG0"),
+               "Deleting airports drops their routes and orphan endpoints");
+}
+
+void testBulkTransaction() {
+    std::cout << "\n=== Testing bulk transactions ===" << std::endl;
+
+    DataStore& store = DataStore::getInstance();
+    store.clearUndoStack();
+    uint64_t versionBefore = store.getGraphSnapshot()->getVersion();
+
+    const int n = 200;
+    {
+        BulkTransaction bulk(store);
+        for (int i = 0; i < n; ++i) {
+            store.addAirport(Airport("BK" + std::to_string(i), "Bulk", "City", "Country", 0.0, i * 0.1));
+        }
+        {
+            BulkTransaction nested(store);
+            for (int i = 0; i + 1 < n; ++i) {
+                store.addRoute(Route("BK" + std::to_string(i), "BK" + std::to_string(i + 1), 10.0, 1.0));
+            }
+        }
+        assertTrue(store.inBulk(), "Nested commit leaves the outer transaction open");
+        assertTrue(store.getGraphSnapshot()->getVersion() == versionBefore &&
+                   !store.getGraph().hasNode("BK0"),
+                   "Readers see the pre-transaction graph until commit");
+        assertTrue(!store.canUndo(), "Undo bookkeeping deferred");
+    }
+
+    auto after = store.getGraphSnapshot();
+    assertTrue(after->getVersion() == versionBefore + 1, "Commit publishes exactly one new version");
+    assertTrue(after->getGraph().hasEdge("BK0", "BK1") &&
+               after->getGraph().hasEdge("BK199", "BK198"),
+               "Committed edits are in the graph");
+    assertTrue(store.canUndo() && store.undo() && !store.canUndo(),
+               "Whole transaction is one undo entry");
+
+    BulkTransaction cleanup(store);
+    for (int i = 0; i < n; ++i) {
+        store.deleteAirport("BK" + std::to_string(i));
+    }
+    cleanup.commit();
+    assertTrue(!store.getGraph().hasNode("BK0") && !store.inBulk(), "Explicit commit");
+}
+
+void testCsvReader() {
+    std::cout << "\n=== Testing CsvReader ===" << std::endl;
+
+    std::string text = "Code,Lat\r\n"
+                       " JFK , 40.6413 \r\n"
+                       "\r\n"
+                       "LAX,-118.4085,extra\n"
+                       "BAD,12abc\n"
+                       "LAST,+7";
+    CsvReader csv(text);
+
+    assertTrue(csv.next() && csv.getFieldCount() == 2 && csv.field(0) == "Code", "Header row");
+
+    double value = 0.0;
+    assertTrue(csv.next() && csv.field(0) == "JFK" && csv.parseDouble(1, value) &&
+               value == 40.6413 && csv.getLineNumber() == 2,
+               "Fields trimmed, CRLF stripped, number parsed");
+
+    assertTrue(csv.next() && csv.getLineNumber() == 4 && csv.getFieldCount() == 3 &&
+               csv.parseDouble(1, value) && value == -118.4085,
+               "Blank line skipped, line numbers kept");
+
+    assertTrue(csv.next() && !csv.parseDouble(1, value) && csv.getLineNumber() == 5 &&
+               csv.getLine() == "BAD,12abc",
+               "Trailing garbage rejected with line number");
+
+    int count = 0;
+    assertTrue(csv.next() && csv.parseInt(1, count) && count == 7, "Last line without newline");
+    assertTrue(!csv.next(), "End of input");
+
+    assertTrue(!CsvReader::toDouble("", value) && !CsvReader::toInt("3.5", count),
+               "Empty and non-integer fields rejected");
+
+    // Chunked parsing sees every row exactly once, with recoverable line numbers
+    std::string many = "H\n";
+    for (int i = 1; i <= 500; ++i) many += "row" + std::to_string(i) + "," + std::to_string(i) + "\n";
+    std::vector<size_t> bounds = CsvReader::chunkBounds(many, 7);
+    bool boundsValid = bounds.front() == 0 && bounds.back() == many.size() && bounds.size() == 8;
+    int rows = 0;
+    int linesBefore = 0;
+    bool linesMatch = true;
+    for (size_t k = 0; k + 1 < bounds.size(); ++k) {
+        boundsValid &= bounds[k] < bounds[k + 1] && (k == 0 || many[bounds[k] - 1] == '\n');
+        std::string_view piece = std::string_view(many).substr(bounds[k], bounds[k + 1] - bounds[k]);
+        CsvReader chunk(piece);
+        if (k == 0) chunk.next();
+        while (chunk.next()) {
+            int n = 0;
+            chunk.parseInt(1, n);
+            linesMatch &= (linesBefore + chunk.getLineNumber() == n + 1);
+            ++rows;
+        }
+        linesBefore += static_cast<int>(std::count(piece.begin(), piece.end(), '\n'));
+    }
+    assertTrue(boundsValid, "Chunks start at line boundaries and cover the text");
+    assertTrue(rows == 500 && linesMatch, "Chunked rows complete with global line numbers");
+    assertTrue(CsvReader::chunkBounds("a\nb", 8).size() == 3, "Tiny input yields fewer chunks");
+}
+
+void testEntityTable() {
+    std::cout << "\n=== Testing EntityTable (hashed pool) ===" << std::endl;
+
+    EntityTable<Airport> table;
+    assertTrue(table.try_emplace("JFK", "JFK", "Kennedy", "New York", "USA", 40.6, -73.8).second &&
+               !table.try_emplace("JFK").second && table.size() == 1,
+               "Insert once, duplicate rejected");
+
+    auto jfk = table.find("JFK");
+    EntityTable<Airport>::Handle handle = jfk.handle();
+    const Airport* pointer = &jfk->second;
+    for (int i = 0; i < 5000; ++i) {
+        table["X" + std::to_string(i)].code = "X" + std::to_string(i);
+    }
+    assertTrue(table.find("JFK").handle() == handle && &table.get(handle) == pointer &&
+               table.get(handle).name == "Kennedy",
+               "Handles and pointers stable across growth");
+
+    table["LHR"].code = "LHR";
+    assertTrue(table.findJoined("X1", '2', "3") == table.find("X123") &&
+               table.findJoined("LH", 'R', "") == table.find("LHR") &&
+               table.findJoined("X12", '-', "3") == table.end(),
+               "Joined lookup matches the concatenated key");
+
+    table.erase("JFK");
+    assertTrue(!table.contains("JFK") && !table.isLive(handle), "Erase frees the handle");
+    auto sfo = table.try_emplace("SFO").first;
+    assertTrue(&sfo->second == pointer && sfo.handle() != handle && !table.isLive(handle) &&
+               table.at(handle) == table.end(),
+               "Reused slot gets a new handle; the old one stays dead");
+    bool staleGetThrows = false;
+    try {
+        table.get(handle);
+    } catch (const std::out_of_range&) {
+        staleGetThrows = true;
+    }
+    assertTrue(staleGetThrows, "get() rejects a stale handle");
+
+    // Random churn (tombstones, rehashes) against std::map
+    EntityTable<int> churn;
+    std::map<std::string, int> expected;
+    unsigned seed = 12345;
+    bool erasesAgree = true;
+    for (int step = 0; step < 200000; ++step) {
+        seed = seed * 1103515245 + 12345;
+        std::string key = "K" + std::to_string((seed >> 8) % 3000);
+        if ((seed >> 4) % 3 == 0) {
+            erasesAgree = erasesAgree && churn.erase(key) == expected.erase(key);
+        } else {
+            churn[key] = step;
+            expected[key] = step;
+        }
+    }
+    bool same = erasesAgree && churn.size() == expected.size();
+    size_t visited = 0;
+    for (const auto& [key, value] : churn) {
+        auto it = expected.find(key);
+        same = same && it != expected.end() && it->second == value;
+        ++visited;
+    }
+    assertTrue(same && visited == expected.size(), "Contents match std::map after churn");
+
+    std::vector<const int*> byKey = churn.valuesByKey();
+    bool keyOrder = byKey.size() == expected.size();
+    auto expectedIt = expected.begin();
+    for (size_t i = 0; keyOrder && i < byKey.size(); ++i, ++expectedIt) {
+        keyOrder = byKey[i] == &churn.find(expectedIt->first)->second;
+    }
+    assertTrue(keyOrder, "valuesByKey follows std::map order after churn");
+
+    EntityTable<int> copy(churn);
+    churn.clear();
+    bool copied = copy.size() == expected.size();
+    for (const auto& [key, value] : expected) {
+        auto it = copy.find(key);
+        copied = copied && it != copy.end() && it->second == value;
+    }
+    assertTrue(copied && churn.empty() && churn.find("K1") == churn.end(),
+               "Copy independent of the original");
+}
+
+void testBinaryStore() {
+    std::cout << "\n=== Testing BinaryStore (binary image) ===" << std::endl;
+
+    EntityTable<Airport> airports;
+    EntityTable<Aircraft> aircraft;
+    EntityTable<Route> routes;
+    EntityTable<Flight> flights;
+
+    airports["AAA"] = Airport("AAA", "Alpha, Intl", "A City", "A Land", 10.5, -20.25);
+    airports["BBB"] = Airport("BBB", "Bravo", "B City", "B Land", -33.0, 151.0);
+    aircraft["AC1"] = Aircraft("AC1", "Test Jet", 180, 830.0, 2.9);
+    aircraft["AC1"].status = AircraftStatus::MAINTENANCE;
+    routes["AAA-BBB"] = Route("AAA", "BBB", 1234.5, 99.0, true);
+    routes["BBB-CCC"] = Route("BBB", "CCC", 10.0, 1.0, false);
+    Flight flight("FL1", "AC1", {"AAA", "BBB"});
+    flight.totalDistance = 1234.5;
+    flight.departureTime = "2025-01-15T10:00";
+    flights["FL1"] = flight;
+
+    Graph g;
+    g.addEdge("AAA", "BBB", 1234.5, 99.0);
+    g.addEdge("BBB", "AAA", 1234.5, 99.0);
+    CompactGraph cg(g);
+
+    std::string path = (std::filesystem::temp_directory_path() / "skynet_test_image.bin").string();
+    assertTrue(BinaryStore::save(path, airports, aircraft, routes, flights, cg), "Write image");
+
+    BinaryStore::Contents loaded;
+    std::string error;
+    assertTrue(BinaryStore::load(path, loaded, error), "Read image back");
+    assertTrue(loaded.airports.size() == 2 && loaded.airports["AAA"].name == "Alpha, Intl" &&
+               loaded.airports["AAA"].longitude == -20.25,
+               "Airports round-trip (including commas)");
+    assertTrue(loaded.aircraft["AC1"].status == AircraftStatus::MAINTENANCE &&
+               loaded.aircraft["AC1"].capacity == 180,
+               "Aircraft round-trip");
+    assertTrue(loaded.routes.size() == 2 && !loaded.routes["BBB-CCC"].operational,
+               "Routes round-trip");
+    assertTrue(loaded.flights["FL1"].route.size() == 2 &&
+               loaded.flights["FL1"].departureTime == "2025-01-15T10:00",
+               "Flights round-trip");
+
+    const CompactGraph& lg = *loaded.graph;
+    CompactGraph::NodeId a = lg.getNodeId("AAA");
+    assertTrue(lg.getNodeCount() == 2 && lg.getEdgeCount() == 2 &&
+               lg.edgeWeight(lg.edgeBegin(a)) == 1234.5 &&
+               lg.reverseEdgeEnd(a) - lg.reverseEdgeBegin(a) == 1,
+               "Stored CSR adopted with reverse edges");
+
+    // Truncated file is rejected, not half-loaded
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 4);
+    BinaryStore::Contents truncated;
+    assertTrue(!BinaryStore::load(path, truncated, error), "Truncated image rejected");
+    std::filesystem::remove(path);
+}
+
+void testJournal() {
+    std::cout << "\n=== Testing Journal (write-ahead log) ===" << std::endl;
+
+    std::string path = (std::filesystem::temp_directory_path() / "skynet_test_journal.log").string();
+    std::filesystem::remove(path);
+
+    auto readBack = [&]() {
+        std::vector<std::string> records;
+        Journal::replay(path, [&](std::string_view r) { records.emplace_back(r); });
+        return records;
+    };
+
+    {
+        Journal journal;
+        assertTrue(journal.open(path) && journal.isOpen(), "Open journal");
+        journal.append("PUT_FLIGHT,FL1");
+        journal.append("DEL_FLIGHT,FL0");
+        assertTrue(journal.sync() && readBack().size() == 2, "Synced records are on disk");
+
+        // Concurrent appenders share group commits; order is kept per thread
+        std::vector<std::thread> writers;
+        for (int t = 0; t < 4; ++t) {
+            writers.emplace_back([&journal, t]() {
+                for (int i = 0; i < 250; ++i) {
+                    journal.append("T" + std::to_string(t) + "," + std::to_string(i));
+                }
+                journal.sync();
+            });
+        }
+        for (auto& writer : writers) writer.join();
+
+        std::vector<std::string> records = readBack();
+        bool ordered = records.size() == 1002;
+        int last[4] = {-1, -1, -1, -1};
+        for (size_t i = 2; i < records.size(); ++i) {
+            int t = records[i][1] - '0';
+            int n = std::stoi(records[i].substr(3));
+            ordered &= (n == last[t] + 1);
+            last[t] = n;
+        }
+        assertTrue(ordered && journal.getRecordCount() == 1002,
+                   "Concurrent appends all durable, in order");
+
+        // Compaction up to a mark keeps the records appended after it
+        uint64_t mark = journal.getLastSequence();
+        journal.append("AFTER,1");
+        journal.sync();
+        journal.append("AFTER,2");
+        assertTrue(journal.compact(mark) && journal.getRecordCount() == 2,
+                   "Compaction drops records up to the mark");
+        journal.sync();
+        assertTrue(readBack() == std::vector<std::string>{"AFTER,1", "AFTER,2"},
+                   "Records after the mark stay on disk");
+
+        assertTrue(journal.compact(journal.getLastSequence()) && readBack().empty() &&
+                   journal.getRecordCount() == 0,
+                   "Full compaction empties the log");
+        journal.append("PUT_AIRPORT,AAA");
+    }   // Destructor writes what is still queued
+    assertTrue(readBack() == std::vector<std::string>{"PUT_AIRPORT,AAA"},
+               "Close flushes pending records");
+
+    // Crash mid-append: torn last record is ignored, then cut off on open
+    {
+        std::ofstream torn(path, std::ios::binary | std::ios::app);
+        torn << "PUT_AIRPORT,BB";
+    }
+    assertTrue(readBack().size() == 1, "Torn tail ignored by replay");
+    {
+        Journal journal;
+        journal.open(path);
+        assertTrue(journal.getRecordCount() == 1, "Existing records counted on open");
+        journal.append("PUT_AIRPORT,CCC");
+        journal.sync();
+    }
+    assertTrue(readBack() == std::vector<std::string>{"PUT_AIRPORT,AAA", "PUT_AIRPORT,CCC"},
+               "Append after torn tail starts a clean record");
+
+    // Log cannot be reopened after compaction: records wait, not vanish
+    {
+        Journal journal;
+        journal.open(path);
+        std::filesystem::remove(path);
+        std::filesystem::create_directory(path);
+        bool compacted = journal.compact(journal.getLastSequence());
+        journal.append("PUT_FLIGHT,HELD");
+        bool heldSynced = journal.sync();
+        assertTrue(!compacted && !heldSynced && journal.isOpen() && journal.getRecordCount() == 1,
+                   "Failed reopen reported, record kept queued");
+
+        std::filesystem::remove(path);
+        journal.append("PUT_FLIGHT,NEXT");
+        journal.sync();
+        assertTrue(readBack() == std::vector<std::string>{"PUT_FLIGHT,HELD", "PUT_FLIGHT,NEXT"},
+                   "Flusher reopens the log and writes the held records");
+        assertTrue(journal.compact(journal.getLastSequence()) && journal.sync(),
+                   "Compaction clears the failure");
+    }
+    std::filesystem::remove(path);
+}
+
+void testAtomicFileWriter() {
+    std::cout << "\n=== Testing AtomicFileWriter ===" << std::endl;
+
+    std::string path = (std::filesystem::temp_directory_path() / "skynet_test_atomic.txt").string();
+    auto readAll = [&]() {
+        std::ifstream in(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    };
+
+    {
+        AtomicFileWriter writer(path);
+        assertTrue(writer.isOpen(), "Open temp file");
+        writer.stream() << "Code,Name\n" << "JFK," << 40.5 << "\n";
+        assertTrue(writer.commit() && readAll() == "Code,Name\nJFK,40.5\n", "Commit replaces target");
+    }
+
+    {
+        AtomicFileWriter writer(path);
+        writer.stream() << "half written";
+    }   // No commit: simulates a crash before the rename
+    assertTrue(readAll() == "Code,Name\nJFK,40.5\n" &&
+               !std::filesystem::exists(path + ".tmp"),
+               "Uncommitted write leaves the old file intact");
+
+    // Small buffer forces many flushes plus a direct large write
+    std::string expected;
+    {
+        AtomicFileWriter writer(path, 64);
+        for (int i = 0; i < 1000; ++i) {
+            std::string line = "row" + std::to_string(i) + "\n";
+            writer.stream() << line;
+            expected += line;
+        }
+        std::string block(10000, 'x');
+        writer.write(block.data(), block.size());
+        expected += block;
+        assertTrue(writer.commit(), "Commit after buffered and direct writes");
+    }
+    assertTrue(readAll() == expected, "Content intact across buffer flushes");
+
+    AtomicFileWriter missing((std::filesystem::temp_directory_path() / "no_such_dir" / "x.txt").string());
+    assertTrue(!missing.isOpen() && !missing.commit(), "Unwritable path reported");
+    std::filesystem::remove(path);
+}
+
+void testPersistenceService() {
+    std::cout << "\n=== Testing PersistenceService ===" << std::endl;
+
+    PersistenceService service;
+    assertTrue(service.run([]() { return true; }), "Synchronous job returns its result");
+
+    // Hold the worker in a first job, then send a burst of requests
+    std::mutex gate;
+    std::unique_lock<std::mutex> hold(gate);
+    std::atomic<bool> started(false);
+    std::atomic<int> jobsRun(0);
+    std::atomic<int> lastJob(0);
+    std::atomic<int> callbacks(0);
+    std::atomic<int> failures(0);
+
+    service.submit([&]() {
+        started = true;
+        std::lock_guard<std::mutex> wait(gate);
+        ++jobsRun;
+        return true;
+    });
+    while (!started) std::this_thread::yield();
+
+    for (int i = 1; i <= 5; ++i) {
+        service.submit([&, i]() { ++jobsRun; lastJob = i; return i != 5; },
+                       [&](bool success) { ++callbacks; if (!success) ++failures; });
+    }
+    assertTrue(service.isBusy(), "Busy while a job runs");
+
+    hold.unlock();
+    service.waitIdle();
+    assertTrue(jobsRun == 2 && lastJob == 5, "Waiting requests coalesce into the newest");
+    assertTrue(callbacks == 5 && failures == 5,
+               "Every caller hears the outcome of the job that covered it");
+    assertTrue(!service.isBusy(), "Idle after waitIdle");
+}
+
 void testDataStore() {
     std::cout << "\n=== Testing DataStore ===" << std::endl;
 
@@ -134,10 +1037,616 @@ void testDataStore() {
 
     // Test graph rebuild
     store.rebuildGraph();
-    Graph& graph = store.getGraph();
+    const Graph& graph = store.getGraph();
     assertTrue(graph.getNodeCount() > 0, "Graph has nodes after rebuild");
 }
 
+void testPagedQueries() {
+    std::cout << "\n=== Testing views and paged queries ===" << std::endl;
+
+    DataStore& store = DataStore::getInstance();
+    const size_t flightsBefore = store.getFlightCount();
+    for (int i = 0; i < 25; ++i) {
+        Flight flight("PG" + std::to_string(i), "AC999",
+                      {i % 2 ? "PGA" : "PGB", "PGHUB", "PGC"});
+        if (i % 5 == 0) flight.status = "COMPLETED";
+        store.addFlight(flight);
+    }
+
+    size_t viewed = 0;
+    bool inPlace = true;
+    for (const Flight& flight : store.viewFlights()) {
+        inPlace = inPlace && store.getFlight(flight.flightNumber) == &flight;
+        ++viewed;
+    }
+    assertTrue(viewed == store.getFlightCount() && viewed == flightsBefore + 25 && inPlace,
+               "View walks the stored flights without copying");
+
+    FlightFilter hub;
+    hub.airport = "PGHUB";
+    Page<Flight> first = store.getFlightPage(0, 10, hub);
+    Page<Flight> last = store.getFlightPage(20, 10, hub);
+    std::set<std::string> seen;
+    for (size_t offset = 0; offset < 25; offset += 10) {
+        for (const Flight& flight : store.getFlightPage(offset, 10, hub).items) {
+            seen.insert(flight.flightNumber);
+        }
+    }
+    assertTrue(first.total == 25 && first.items.size() == 10 && last.items.size() == 5 &&
+               seen.size() == 25,
+               "Pages split the matches without gaps or repeats");
+
+    FlightFilter completedAtA;
+    completedAtA.status = "COMPLETED";
+    completedAtA.airport = "PGA";   // Odd numbers that are multiples of 5
+    Page<Flight> filtered = store.getFlightPage(0, 100, completedAtA);
+    assertTrue(filtered.total == 2 && filtered.items.size() == 2, "Status and airport filters combine");
+    assertTrue(store.getFlightPage(0, 0, hub).items.empty() &&
+               store.getFlightPage(0, 0, hub).total == 25,
+               "Limit 0 only counts");
+
+    Page<Route> jfkRoutes = store.getRoutePage(0, 100, "JFK");
+    bool touchesJfk = !jfkRoutes.items.empty();
+    for (const Route& route : jfkRoutes.items) {
+        touchesJfk = touchesJfk && (route.origin == "JFK" || route.destination == "JFK");
+    }
+    assertTrue(touchesJfk, "Route page filtered by airport");
+    assertTrue(store.getAircraftPage(0, 100, AircraftStatus::AVAILABLE).total <= store.getAircraftCount() &&
+               store.getAirportPage(0, 3).items.size() == std::min<size_t>(3, store.getAirportCount()),
+               "Aircraft and airport pages");
+
+    for (int i = 0; i < 25; ++i) {
+        store.deleteFlight("PG" + std::to_string(i));
+    }
+}
+
+void testFlightIndex() {
+    std::cout << "\n=== Testing flight indexes ===" << std::endl;
+
+    int64_t t = TimeUtil::parseMinutes("2025-01-15T10:00");
+    assertTrue(t == 28948920 && TimeUtil::parseMinutes("2025-01-15T10:00:59") == t &&
+               TimeUtil::parseMinutes("2025-01-15 10:00") == t &&
+               TimeUtil::parseMinutes("2024-03-01T00:00") - TimeUtil::parseMinutes("2024-02-28T00:00") == 2 * 1440,
+               "Departure times parse to epoch minutes");
+    assertTrue(TimeUtil::parseMinutes("2025-02-29T10:00") == TimeUtil::NO_TIME &&
+               TimeUtil::parseMinutes("2025-01-15T24:00") == TimeUtil::NO_TIME &&
+               TimeUtil::parseMinutes("10:00") == TimeUtil::NO_TIME &&
+               TimeUtil::formatMinutes(t) == "2025-01-15T10:00" &&
+               TimeUtil::formatMinutes(TimeUtil::parseMinutes("1969-12-31T23:59")) == "1969-12-31T23:59",
+               "Malformed times rejected, formatting round-trips");
+
+    DataStore& store = DataStore::getInstance();
+    auto book = [&](const std::string& number, const std::string& aircraftId,
+                    std::vector<std::string> route, const std::string& departure) {
+        Flight flight(number, aircraftId, route);
+        flight.departureTime = departure;
+        store.addFlight(flight);
+    };
+    book("IX1", "IXAC1", {"IXA", "IXB"}, "2025-03-01T12:00");
+    store.getFlightsByAirport("IXA");   // Builds the index; later edits maintain it
+    book("IX2", "IXAC1", {"IXB", "IXC", "IXB"}, "2025-03-01T09:00");
+    book("IX3", "IXAC2", {"IXC", "IXA"}, "2025-03-01T13:59");
+    book("IX4", "IXAC2", {"IXA", "IXC"}, "not a time");
+
+    auto numbers = [](const std::vector<const Flight*>& found) {
+        std::string joined;
+        for (const Flight* flight : found) joined += flight->flightNumber + " ";
+        return joined;
+    };
+    int64_t ten = TimeUtil::parseMinutes("2025-03-01T10:00");
+    int64_t two = TimeUtil::parseMinutes("2025-03-01T14:00");
+    assertTrue(numbers(store.getFlightsByAirport("IXA", ten, two)) == "IX1 IX3 ",
+               "Airport and time window query");
+    assertTrue(numbers(store.getFlightsByAirport("IXB")) == "IX2 IX1 ",
+               "Airport index ordered by departure, revisited airport listed once");
+    assertTrue(numbers(store.getFlightsByAircraft("IXAC2")) == "IX4 IX3 ",
+               "Aircraft index (unparsed time first)");
+    assertTrue(numbers(store.getFlightsDepartingBetween(ten - 60, ten + 1)) == "IX2 ",
+               "Departure range query");
+
+    Page<Flight> page = store.getFlightPage(1, 1, FlightFilter{"", "IXA"});
+    assertTrue(page.total == 3 && page.items.size() == 1 && page.items[0].flightNumber == "IX1",
+               "Airport-filtered page served by the index");
+
+    Flight candidate("IX9", "IXAC1", {"IXA", "IXB"});
+    candidate.departureTime = "2025-03-01T12:30";
+    assertTrue(!Scheduling::canSchedule(candidate, store), "Indexed conflict check");
+
+    for (const char* number : {"IX1", "IX2", "IX3", "IX4"}) {
+        store.deleteFlight(number);
+    }
+    assertTrue(store.getFlightsByAirport("IXA").empty() && store.getFlightsByAircraft("IXAC1").empty() &&
+               Scheduling::canSchedule(candidate, store),
+               "Deleted flights leave the indexes");
+}
+
+void testScheduling() {
+    std::cout << "\n=== Testing scheduling conflicts ===" << std::endl;
+
+    auto flight = [](const std::string& number, const std::string& aircraftId,
+                     const std::string& departure, double hours) {
+        Flight f(number, aircraftId, {"AAA", "BBB"});
+        f.departureTime = departure;
+        f.estimatedTime = hours;
+        return f;
+    };
+
+    // AC1: S1 10:00-12:00 (+45 turnaround), S2 12:45 back-to-back,
+    // S3 12:30 overlaps both. AC2 overlaps in time but is another aircraft.
+    std::vector<Flight> flights = {
+        flight("S1", "AC1", "2025-05-01T10:00", 2.0),
+        flight("S2", "AC1", "2025-05-01T12:45", 1.0),
+        flight("S3", "AC1", "2025-05-01T12:30:00", 0.5),
+        flight("S4", "AC2", "2025-05-01T10:30", 3.0),
+        flight("S5", "AC1", "garbage", 1.0),
+    };
+    flights.push_back(flight("S6", "AC1", "2025-05-01T10:15", 1.0));
+    flights.back().status = "COMPLETED";
+
+    auto conflicts = Scheduling::detectConflicts(flights);
+    std::set<std::pair<std::string, std::string>> found(conflicts.begin(), conflicts.end());
+    std::set<std::pair<std::string, std::string>> expected = {{"S1", "S3"}, {"S3", "S2"}};
+    assertTrue(found == expected && conflicts.size() == 2,
+               "Only overlapping windows on the same aircraft conflict");
+
+    assertTrue(Scheduling::canSchedule(flight("N1", "AC1", "2025-05-01T14:30", 1.0), flights) &&
+               !Scheduling::canSchedule(flight("N2", "AC1", "2025-05-01T14:00", 1.0), flights) &&
+               Scheduling::canSchedule(flight("N3", "AC3", "2025-05-01T12:00", 1.0), flights) &&
+               !Scheduling::canSchedule(flight("N4", "AC3", "soon", 1.0), flights),
+               "canSchedule checks the time window");
+
+    auto gantt = Scheduling::generateGanttData(flights);
+    assertTrue(gantt[0].endTime == "2025-05-01T12:00" && gantt[2].endTime == "2025-05-01T13:00" &&
+               gantt[4].endTime.empty(),
+               "Gantt end time is the arrival");
+
+    // Sweep agrees with a pairwise check on random schedules
+    std::vector<Flight> random;
+    unsigned seed = 99;
+    for (int i = 0; i < 600; ++i) {
+        seed = seed * 1103515245 + 12345;
+        int minute = (seed >> 8) % (3 * 1440);
+        char departure[32];
+        std::snprintf(departure, sizeof(departure), "2025-06-%02dT%02d:%02d",
+                      1 + minute / 1440, minute % 1440 / 60, minute % 60);
+        random.push_back(flight("R" + std::to_string(i), "RA" + std::to_string(seed % 7),
+                                departure, ((seed >> 4) % 40) / 4.0));
+    }
+    std::set<std::pair<std::string, std::string>> brute;
+    for (size_t i = 0; i < random.size(); ++i) {
+        for (size_t j = i + 1; j < random.size(); ++j) {
+            int64_t s1, e1, s2, e2;
+            Scheduling::getTimeWindow(random[i], s1, e1);
+            Scheduling::getTimeWindow(random[j], s2, e2);
+            if (random[i].aircraftId == random[j].aircraftId && s1 < e2 && s2 < e1) {
+                brute.insert(std::minmax(random[i].flightNumber, random[j].flightNumber));
+            }
+        }
+    }
+    std::set<std::pair<std::string, std::string>> swept;
+    for (const auto& [a, b] : Scheduling::detectConflicts(random)) {
+        swept.insert(std::minmax(a, b));
+    }
+    assertTrue(!brute.empty() && swept == brute, "Sweep matches the pairwise check");
+}
+
+void testFlightScheduler() {
+    std::cout << "\n=== Testing live booking checks ===" << std::endl;
+
+    DataStore& store = DataStore::getInstance();
+    auto flight = [](const std::string& number, const std::string& aircraftId,
+                     const std::string& departure, double hours) {
+        Flight f(number, aircraftId, {"SQA", "SQB"});
+        f.departureTime = departure;
+        f.estimatedTime = hours;
+        return f;
+    };
+    auto numbers = [](const std::vector<const Flight*>& found) {
+        std::string joined;
+        for (const Flight* f : found) joined += f->flightNumber + " ";
+        return joined;
+    };
+
+    store.findScheduleConflicts(flight("SQ0", "SQAC", "2025-07-01T00:00", 1.0));   // Builds the schedule
+    store.addFlight(flight("SQ1", "SQAC", "2025-07-01T00:00", 20.0));   // Until 20:45
+    store.addFlight(flight("SQ2", "SQAC", "2025-07-01T22:00", 1.0));    // Until 23:45
+    Flight completed = flight("SQ3", "SQAC", "2025-07-01T19:00", 1.0);
+    completed.status = "COMPLETED";
+    store.addFlight(completed);
+
+    assertTrue(numbers(store.findScheduleConflicts(flight("SQ9", "SQAC", "2025-07-01T19:30", 3.0))) ==
+               "SQ1 SQ2 ",
+               "Booking check reports each conflicting flight");
+    assertTrue(store.findScheduleConflicts(flight("SQ9", "SQAC", "2025-07-01T20:45", 0.5)).empty() &&
+               store.findScheduleConflicts(flight("SQ9", "OTHER", "2025-07-01T12:00", 1.0)).empty(),
+               "Free slot and other aircraft accepted");
+    assertTrue(store.findScheduleConflicts(flight("SQ2", "SQAC", "2025-07-01T22:00", 1.0)).empty(),
+               "A stored flight does not conflict with itself");
+
+    store.deleteFlight("SQ1");
+    assertTrue(numbers(store.findScheduleConflicts(flight("SQ9", "SQAC", "2025-07-01T19:30", 3.0))) ==
+               "SQ2 ",
+               "Deleted flight frees its window");
+
+    // Live schedule agrees with the list-based check
+    std::vector<Flight> booked;
+    unsigned seed = 4242;
+    bool agree = true;
+    for (int i = 0; i < 400; ++i) {
+        seed = seed * 1103515245 + 12345;
+        int minute = (seed >> 8) % (2 * 1440);
+        char departure[32];
+        std::snprintf(departure, sizeof(departure), "2025-08-%02dT%02d:%02d",
+                      1 + minute / 1440, minute % 1440 / 60, minute % 60);
+        Flight candidate = flight("SR" + std::to_string(i), "SRAC" + std::to_string(seed % 3),
+                                  departure, ((seed >> 4) % 24) / 4.0);
+        bool fits = store.findScheduleConflicts(candidate).empty();
+        agree = agree && fits == Scheduling::canSchedule(candidate, booked) &&
+                fits == Scheduling::canSchedule(candidate, store);
+        if (fits) {
+            store.addFlight(candidate);
+            booked.push_back(candidate);
+        }
+    }
+    assertTrue(agree && booked.size() > 10 && Scheduling::detectConflicts(booked).empty(),
+               "Accepted bookings never overlap");
+
+    for (const Flight& f : booked) store.deleteFlight(f.flightNumber);
+    store.deleteFlight("SQ2");
+    store.deleteFlight("SQ3");
+}
+
+void testFleetAssignment() {
+    std::cout << "\n=== Testing fleet assignment ===" << std::endl;
+
+    // Hungarian method against brute force, square and rectangular
+    unsigned seed = 777;
+    bool optimal = true;
+    for (int trial = 0; trial < 60; ++trial) {
+        size_t rows = 1 + trial % 5, cols = 1 + (trial / 5) % 5;
+        std::vector<double> costs(rows * cols);
+        for (double& c : costs) {
+            seed = seed * 1103515245 + 12345;
+            c = (seed >> 8) % 100;
+        }
+        std::vector<int> match = FleetAssignment::solveAssignment(costs, rows, cols);
+        double total = 0.0;
+        std::set<int> usedCols;
+        for (size_t i = 0; i < rows; ++i) {
+            if (match[i] >= 0) {
+                total += costs[i * cols + match[i]];
+                usedCols.insert(match[i]);
+            }
+        }
+
+        // Best over every injection of the smaller side into the larger
+        std::vector<size_t> perm(std::max(rows, cols));
+        for (size_t k = 0; k < perm.size(); ++k) perm[k] = k;
+        double best = 1e18;
+        do {
+            double sum = 0.0;
+            for (size_t k = 0; k < std::min(rows, cols); ++k) {
+                sum += rows <= cols ? costs[k * cols + perm[k]] : costs[perm[k] * cols + k];
+            }
+            best = std::min(best, sum);
+        } while (std::next_permutation(perm.begin(), perm.end()));
+
+        optimal = optimal && usedCols.size() == std::min(rows, cols) && total == best;
+    }
+    assertTrue(optimal, "Assignment is a minimum-cost matching");
+
+    auto aircraft = [](const std::string& id, int seats, double fuel) {
+        return Aircraft(id, "Test", seats, 500.0, fuel);
+    };
+    auto flight = [](const std::string& number, const std::string& from, const std::string& to,
+                     const std::string& departure, double distance) {
+        Flight f(number, "", {from, to});
+        f.departureTime = departure;
+        f.totalDistance = distance;
+        return f;
+    };
+
+    // Two hours at 500 km/h plus turnaround: busy 08:00-10:45
+    std::vector<Aircraft> fleet = {aircraft("THIRSTY", 300, 5.0), aircraft("FRUGAL", 150, 2.0),
+                                   aircraft("GROUNDED", 400, 1.0)};
+    fleet[2].status = AircraftStatus::MAINTENANCE;
+    std::vector<Flight> planned = {
+        flight("P1", "AAA", "BBB", "2025-09-01T08:00", 1000.0),
+        flight("P2", "CCC", "DDD", "2025-09-01T08:30", 3000.0),
+        flight("P3", "BBB", "AAA", "2025-09-01T11:00", 1000.0),
+        flight("P4", "DDD", "CCC", "2025-09-01T09:00", 500.0),
+        flight("P5", "AAA", "BBB", "not a time", 1000.0)};
+
+    FleetAssignment::Result result = FleetAssignment::assign(planned, fleet, {});
+    const auto& a = result.assignments;
+    assertTrue(a[1].aircraftId == "FRUGAL" && a[0].aircraftId == "THIRSTY" &&
+               a[2].aircraftId == "THIRSTY" && a[3].aircraftId.empty() && a[4].aircraftId.empty(),
+               "Long flight gets the efficient aircraft; return leg chains at its origin");
+    assertTrue(result.assignedCount == 3 && result.totalFuelCost == 5000.0 + 6000.0 + 5000.0 &&
+               a[1].fuelCost == 6000.0 && a[1].estimatedTime == 6.0,
+               "Fuel cost and duration on the assigned aircraft");
+
+    // Seats and the booked schedule: FRUGAL is too small, and THIRSTY's
+    // booked flight leaves AAA, so P1 must not strand it at BBB
+    FleetAssignment::Options options;
+    options.requiredSeats = {200, 0, 0, 0, 0};
+    Flight booked = flight("B1", "AAA", "EEE", "2025-09-01T12:00", 500.0);
+    booked.aircraftId = "THIRSTY";
+    booked.estimatedTime = 1.0;
+    result = FleetAssignment::assign({planned[0]}, fleet, {booked}, options);
+    assertTrue(result.assignedCount == 0, "Seats and positioning rule out every aircraft");
+    booked.route = {"BBB", "EEE"};
+    result = FleetAssignment::assign({planned[0]}, fleet, {booked}, options);
+    assertTrue(result.assignments[0].aircraftId == "THIRSTY", "Chains into the booked flight");
+
+    // Random day on a small network: every aircraft's flights chain and
+    // never overlap
+    std::vector<Aircraft> bigFleet;
+    for (int i = 0; i < 30; ++i) {
+        bigFleet.push_back(aircraft("FA" + std::to_string(i), 100 + i * 10, 1.0 + i % 7));
+    }
+    std::vector<Flight> day;
+    for (int i = 0; i < 400; ++i) {
+        seed = seed * 1103515245 + 12345;
+        int minute = (seed >> 8) % 1440;
+        char departure[32];
+        std::snprintf(departure, sizeof(departure), "2025-09-02T%02d:%02d", minute / 60, minute % 60);
+        std::string from(1, 'K' + (seed >> 4) % 5), to(1, 'K' + (seed >> 12) % 5);
+        if (from == to) to = "Z";
+        day.push_back(flight("D" + std::to_string(i), from, to, departure, 200.0 + (seed >> 16) % 1500));
+    }
+    options = FleetAssignment::Options();
+    options.threadCount = 4;
+    result = FleetAssignment::assign(day, bigFleet, {}, options);
+
+    std::vector<Flight> flown;
+    for (size_t i = 0; i < day.size(); ++i) {
+        if (result.assignments[i].aircraftId.empty()) continue;
+        Flight f = day[i];
+        f.aircraftId = result.assignments[i].aircraftId;
+        f.estimatedTime = result.assignments[i].estimatedTime;
+        flown.push_back(f);
+    }
+    std::sort(flown.begin(), flown.end(), [](const Flight& x, const Flight& y) {
+        return std::tie(x.aircraftId, x.departureTime) < std::tie(y.aircraftId, y.departureTime);
+    });
+    bool chained = true;
+    for (size_t i = 1; i < flown.size(); ++i) {
+        if (flown[i].aircraftId == flown[i - 1].aircraftId) {
+            chained = chained && flown[i].getOrigin() == flown[i - 1].getDestination();
+        }
+    }
+    assertTrue(result.assignedCount == flown.size() && flown.size() > 30 && chained &&
+               Scheduling::detectConflicts(flown).empty(),
+               "Assigned flights chain by airport and never overlap");
+}
+
+void testConnectionScan() {
+    std::cout << "\n=== Testing connection scan ===" << std::endl;
+
+    auto flight = [](const std::string& number, std::vector<std::string> route,
+                     const std::string& departure, double hours) {
+        Flight f(number, "CSAC", route);
+        f.departureTime = departure;
+        f.estimatedTime = hours;
+        return f;
+    };
+    auto at = [](const char* text) { return TimeUtil::parseMinutes(text); };
+
+    std::vector<Flight> schedule = {
+        flight("C1", {"AAA", "BBB"}, "2025-10-01T08:00", 2.0),
+        flight("C2", {"BBB", "CCC"}, "2025-10-01T10:30", 1.0),   // 30 min after C1 lands
+        flight("C3", {"BBB", "CCC"}, "2025-10-01T11:00", 1.0),
+        flight("C4", {"AAA", "CCC"}, "2025-10-01T09:00", 4.0),
+        flight("C5", {"AAA", "DDD", "EEE"}, "2025-10-01T12:00", 3.0),
+        flight("C6", {"AAA", "CCC"}, "2025-10-01T06:00", 1.0)};
+    schedule.back().status = "CANCELLED";
+    Timetable timetable = Timetable::build(schedule);
+    ConnectionScan engine;
+
+    ConnectionScan::Itinerary trip = engine.findEarliestArrival(timetable, "AAA", "CCC",
+                                                                at("2025-10-01T05:00"));
+    assertTrue(trip.found && trip.legs.size() == 2 && trip.legs[0].flightNumber == "C1" &&
+               trip.legs[1].flightNumber == "C3" && trip.arrival == at("2025-10-01T12:00") &&
+               trip.departure == at("2025-10-01T08:00") && trip.getTravelMinutes() == 240,
+               "Earliest arrival keeps the minimum connection time");
+    trip = engine.findEarliestArrival(timetable, "AAA", "CCC", at("2025-10-01T05:00"), 30);
+    assertTrue(trip.found && trip.legs[1].flightNumber == "C2" && trip.arrival == at("2025-10-01T11:30"),
+               "Shorter connection time catches the earlier flight");
+    trip = engine.findEarliestArrival(timetable, "AAA", "CCC", at("2025-10-01T08:01"));
+    assertTrue(trip.found && trip.getTransfers() == 0 && trip.legs[0].flightNumber == "C4",
+               "Departure time rules out flights already gone");
+
+    trip = engine.findEarliestArrival(timetable, "AAA", "EEE", at("2025-10-01T11:00"));
+    assertTrue(trip.found && trip.legs.size() == 1 && trip.legs[0].to == "EEE" &&
+               trip.arrival == at("2025-10-01T15:00") &&
+               trip.getPath() == std::vector<std::string>({"AAA", "EEE"}),
+               "Through an intermediate stop without changing flights");
+    trip = engine.findEarliestArrival(timetable, "DDD", "EEE", at("2025-10-01T13:00"));
+    assertTrue(trip.found && trip.departure == at("2025-10-01T13:30"),
+               "Boarding at an intermediate stop uses the leg's own time");
+
+    assertTrue(!engine.findEarliestArrival(timetable, "CCC", "AAA", at("2025-10-01T00:00")).found &&
+               !engine.findEarliestArrival(timetable, "AAA", "CCC", at("2025-10-01T12:00")).found &&
+               !engine.findEarliestArrival(timetable, "AAA", "ZZZ", at("2025-10-01T00:00")).found,
+               "No itinerary backwards, too late, or to an unknown airport");
+
+    // Against a fixed-point relaxation on random single-leg schedules
+    unsigned seed = 99;
+    bool agree = true;
+    for (int round = 0; round < 20; ++round) {
+        std::vector<Flight> flights;
+        for (int i = 0; i < 300; ++i) {
+            seed = seed * 1103515245 + 12345;
+            int minute = (seed >> 8) % 1440;
+            char departure[32];
+            std::snprintf(departure, sizeof(departure), "2025-10-02T%02d:%02d", minute / 60, minute % 60);
+            std::string from(1, 'K' + (seed >> 4) % 12), to(1, 'K' + (seed >> 16) % 12);
+            if (from == to) continue;
+            flights.push_back(flight("R" + std::to_string(i), {from, to}, departure, 0.5 + (seed >> 20) % 6));
+        }
+        Timetable random = Timetable::build(flights);
+        int64_t start = at("2025-10-02T03:00");
+
+        std::map<std::string, int64_t> best = {{"K", start}};
+        for (bool changed = true; changed;) {
+            changed = false;
+            for (const Flight& f : flights) {
+                int64_t dep = at(f.departureTime.c_str());
+                int64_t arr = dep + static_cast<int64_t>(f.estimatedTime * 60);
+                auto from = best.find(f.getOrigin());
+                if (from == best.end()) continue;
+                int64_t readyAt = from->second + (f.getOrigin() == "K" ? 0 : 45);
+                auto to = best.find(f.getDestination());
+                if (readyAt <= dep && (to == best.end() || arr < to->second)) {
+                    best[f.getDestination()] = arr;
+                    changed = true;
+                }
+            }
+        }
+        for (char c = 'L'; c < 'K' + 12; ++c) {
+            std::string code(1, c);
+            ConnectionScan::Itinerary found = engine.findEarliestArrival(random, "K", code, start, 45, 1440);
+            bool expected = best.count(code) > 0;
+            agree = agree && found.found == expected && (!expected || found.arrival == best[code]);
+        }
+    }
+    assertTrue(agree, "Scan matches exhaustive relaxation");
+
+    // The store's timetable follows booking changes
+    DataStore& store = DataStore::getInstance();
+    auto before = store.getTimetable();
+    store.addFlight(flight("CS1", {"CSX", "CSY"}, "2025-10-03T10:00", 1.0));
+    auto after = store.getTimetable();
+    trip = engine.findEarliestArrival(*after, "CSX", "CSY", at("2025-10-03T09:00"));
+    assertTrue(before != after && trip.found && trip.legs[0].flightNumber == "CS1",
+               "Store timetable includes new bookings");
+    store.deleteFlight("CS1");
+
+    // Moving a stop re-splits the flight's leg times
+    store.addAirport(Airport("CSP", "Timetable P", "City", "Country", 0.0, 0.0));
+    store.addAirport(Airport("CSQ", "Timetable Q", "City", "Country", 0.0, 1.0));
+    store.addAirport(Airport("CSR", "Timetable R", "City", "Country", 0.0, 4.0));
+    store.addFlight(flight("CS2", {"CSP", "CSQ", "CSR"}, "2025-10-03T10:00", 4.0));
+    auto firstLeg = [&]() {
+        return engine.findEarliestArrival(*store.getTimetable(), "CSP", "CSQ",
+                                          at("2025-10-03T09:00")).arrival;
+    };
+    int64_t nearStop = firstLeg();
+    store.updateAirport(Airport("CSQ", "Timetable Q", "City", "Country", 0.0, 3.0));
+    assertTrue(nearStop == at("2025-10-03T11:00") && firstLeg() == at("2025-10-03T13:00"),
+               "Airport edits refresh the timetable");
+    store.deleteFlight("CS2");
+    for (const char* code : {"CSP", "CSQ", "CSR"}) store.deleteAirport(code);
+}
+
+void testMultiCriteriaOptimizer() {
+    std::cout << "\n=== Testing multi-criteria optimizer ===" << std::endl;
+
+    // Direct but expensive, one cheaper stop, two cheapest stops, and a
+    // detour the one-stop path dominates
+    Graph g;
+    g.addEdge("PA", "PB", 100.0, 500.0);
+    g.addEdge("PA", "PC", 60.0, 100.0);
+    g.addEdge("PC", "PB", 60.0, 100.0);
+    g.addEdge("PA", "PD", 70.0, 50.0);
+    g.addEdge("PD", "PE", 70.0, 50.0);
+    g.addEdge("PE", "PB", 70.0, 50.0);
+    g.addEdge("PA", "PF", 65.0, 150.0);
+    g.addEdge("PF", "PB", 65.0, 150.0);
+    CompactGraph cg(g);
+
+    std::vector<PathResult> frontier = MultiCriteriaOptimizer::getParetoFrontier(cg, "PA", "PB");
+    assertTrue(frontier.size() == 3 && frontier[0].path.size() == 2 &&
+               frontier[1].path == std::vector<std::string>({"PA", "PC", "PB"}) &&
+               frontier[2].totalCost == 150.0 && frontier[2].totalDistance == 210.0,
+               "Frontier holds each tradeoff once, shortest first");
+    assertTrue(std::abs(frontier[1].estimatedTime -
+                        (120.0 / MultiCriteriaOptimizer::CRUISE_SPEED_KMH +
+                         MultiCriteriaOptimizer::CONNECTION_HOURS)) < 1e-9,
+               "Time counts flying and connections");
+
+    MultiCriteriaOptimizer::ParetoOptions oneStop;
+    oneStop.maxStops = 1;
+    assertTrue(MultiCriteriaOptimizer::getParetoFrontier(g, "PA", "PB", oneStop).size() == 2 &&
+               MultiCriteriaOptimizer::getParetoFrontier(cg, "PB", "PA").empty(),
+               "Stop limit and unreachable destination");
+
+    MultiCriteriaOptimizer::Criteria byCost{0.0, 1.0, 0.0, 3};
+    MultiCriteriaOptimizer::Criteria byDistance{1.0, 0.0, 0.0, 3};
+    MultiCriteriaOptimizer::Criteria cheapOneStop{0.0, 1.0, 0.0, 1};
+    assertTrue(MultiCriteriaOptimizer::optimize(cg, "PA", "PB", byCost).totalCost == 150.0 &&
+               MultiCriteriaOptimizer::optimize(cg, "PA", "PB", byDistance).totalDistance == 100.0 &&
+               MultiCriteriaOptimizer::optimize(g, "PA", "PB", cheapOneStop).totalCost == 200.0,
+               "Weights pick different frontier paths");
+
+    // Against brute force over every path on random networks
+    unsigned seed = 2024;
+    bool exact = true, covered = true, smaller = true;
+    for (int round = 0; round < 15; ++round) {
+        Graph random;
+        const int n = 9;
+        for (int i = 0; i < n * 4; ++i) {
+            seed = seed * 1103515245 + 12345;
+            int a = (seed >> 8) % n, b = (seed >> 16) % n;
+            if (a == b) continue;
+            random.addEdge("Q" + std::to_string(a), "Q" + std::to_string(b),
+                           10.0 + (seed >> 4) % 90, 5.0 + (seed >> 12) % 90);
+        }
+        random.addNode("Q0");
+        random.addNode("Q8");
+        CompactGraph rc(random);
+
+        // Every (distance, cost, legs) of paths with at most 4 legs
+        std::set<std::tuple<double, double, int>> all;
+        std::function<void(const std::string&, double, double, int, std::set<std::string>&)> walk =
+            [&](const std::string& at, double d, double c, int legs, std::set<std::string>& seen) {
+                if (at == "Q8") { all.insert({d, c, legs}); return; }
+                if (legs == 4) return;
+                for (const Edge& e : random.neighbors(at)) {
+                    if (seen.count(e.destination)) continue;
+                    seen.insert(e.destination);
+                    walk(e.destination, d + e.weight, c + e.cost, legs + 1, seen);
+                    seen.erase(e.destination);
+                }
+            };
+        std::set<std::string> seen = {"Q0"};
+        walk("Q0", 0.0, 0.0, 0, seen);
+
+        std::set<std::tuple<double, double, int>> expected;
+        for (const auto& p : all) {
+            bool dominated = false;
+            for (const auto& q : all) {
+                dominated = dominated || (q != p && std::get<0>(q) <= std::get<0>(p) &&
+                                          std::get<1>(q) <= std::get<1>(p) && std::get<2>(q) <= std::get<2>(p));
+            }
+            if (!dominated) expected.insert(p);
+        }
+
+        std::set<std::tuple<double, double, int>> found;
+        for (const PathResult& p : MultiCriteriaOptimizer::getParetoFrontier(rc, "Q0", "Q8")) {
+            found.insert({p.totalDistance, p.totalCost, static_cast<int>(p.path.size()) - 1});
+        }
+        exact = exact && found == expected;
+
+        MultiCriteriaOptimizer::ParetoOptions loose;
+        loose.epsilon = 0.25;
+        std::vector<PathResult> approx = MultiCriteriaOptimizer::getParetoFrontier(rc, "Q0", "Q8", loose);
+        smaller = smaller && approx.size() <= expected.size();
+        for (const auto& p : expected) {
+            bool any = false;
+            for (const PathResult& a : approx) {
+                any = any || (a.totalDistance <= std::get<0>(p) * 1.25 + 1e-9 &&
+                              a.totalCost <= std::get<1>(p) * 1.25 + 1e-9 &&
+                              static_cast<int>(a.path.size()) - 1 <= std::get<2>(p));
+            }
+            covered = covered && any;
+        }
+    }
+    assertTrue(exact, "Frontier equals brute-force non-dominated set");
+    assertTrue(covered && smaller, "Epsilon frontier covers the exact one with fewer paths");
+}
+
 // Integration Tests
 void testCompleteWorkflow() {
     std::cout << "\n=== Testing Complete Flight Planning Workflow ===" << std::endl;
@@ -156,7 +1665,7 @@ void testCompleteWorkflow() {
     std::string dest = airports.size() > 1 ? airports[1].code : airports[0].code;
 
     // Plan a route
-    Graph& graph = store.getGraph();
+    const Graph& graph = store.getGraph();
     PathResult path = Dijkstra::findShortestPath(graph, origin, dest);
 
     if (path.found) {
@@ -177,7 +1686,7 @@ void testPerformance() {
     std::cout << "\n=== Performance Tests ===" << std::endl;
 
     DataStore& store = DataStore::getInstance();
-    Graph& graph = store.getGraph();
+    const Graph& graph = store.getGraph();
 
     std::cout << "Graph statistics:" << std::endl;
     std::cout << "  Nodes: " << graph.getNodeCount() << std::endl;
@@ -211,7 +1720,30 @@ int main() {
         testHaversine();
         testGraph();
         testDijkstra();
+        testCompactGraph();
+        testSearchEngine();
+        testAStar();
+        testBidirectional();
+        testContractionHierarchy();
+        testDistanceMatrix();
+        testMultiCriteriaOptimizer();
+        testQueryExecutor();
+        testGraphSnapshot();
+        testIncrementalGraph();
+        testBulkTransaction();
+        testCsvReader();
+        testEntityTable();
+        testBinaryStore();
+        testJournal();
+        testAtomicFileWriter();
+        testPersistenceService();
         testDataStore();
+        testPagedQueries();
+        testFlightIndex();
+        testScheduling();
+        testFlightScheduler();
+        testFleetAssignment();
+        testConnectionScan();
 
         // Integration tests
         testCompleteWorkflow();